@@ -4,6 +4,8 @@ release_no_lp = ["-DCMAKE_BUILD_TYPE=Release", "-DUSE_LP=NO"]
 # USE_GLIBCXX_DEBUG is not compatible with USE_LP (see issue983).
 glibcxx_debug = ["-DCMAKE_BUILD_TYPE=Debug", "-DUSE_LP=NO", "-DUSE_GLIBCXX_DEBUG=YES"]
 minimal = ["-DCMAKE_BUILD_TYPE=Release", "-DDISABLE_PLUGINS_BY_DEFAULT=YES"]
+profile = ["-DCMAKE_BUILD_TYPE=Release", "-DUSE_PROFILING=YES"]
+benchmarks = ["-DCMAKE_BUILD_TYPE=Release", "-DBUILD_BENCHMARKS=YES"]
 
 DEFAULT = "release"
 DEBUG = "debug"
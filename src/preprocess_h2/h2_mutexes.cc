@@ -239,7 +239,9 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
         //  cout << i << "-" << num_vals[i] << endl;
     }
     //Initialize everything to NOT_REACHED (mutexes will be set to spurious)
-    m_values.resize(number_props * number_props, NOT_REACHED);
+    words_per_row = (number_props + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    reached_pairs.assign(static_cast<size_t>(number_props) * words_per_row, 0);
+    spurious_pairs.assign(static_cast<size_t>(number_props) * words_per_row, 0);
 
     //Set to spurious variables with themselves
     for (int var = 0; var < num_vars; ++var) {
@@ -247,10 +249,8 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
             int p_index_1 = p_index[var][val1];
             for (int val2 = val1 + 1; val2 < num_vals[var]; ++val2) {
                 int p_index_2 = p_index[var][val2];
-                int pos1 = position(p_index_1, p_index_2);
-                int pos2 = position(p_index_2, p_index_1);
-                m_values[pos1] = SPURIOUS;
-                m_values[pos2] = SPURIOUS;
+                set_value(p_index_1, p_index_2, SPURIOUS);
+                set_value(p_index_2, p_index_1, SPURIOUS);
             }
         }
     }
@@ -290,8 +290,8 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
                     //cout << "Initialize mutex: " << var1 <<"-" << val1 << " "  << variables[var1]->get_fact_name(val1) << " - " << var2<< "-" << val2 << " "  << variables[var2]->get_fact_name(val2) << endl;
 
                     // set the pairs that are mutex as spurious
-                    m_values[position(p_index[var1][val1], p_index[var2][val2])] = SPURIOUS;
-                    m_values[position(p_index[var2][val2], p_index[var1][val1])] = SPURIOUS;
+                    set_value(p_index[var1][val1], p_index[var2][val2], SPURIOUS);
+                    set_value(p_index[var2][val2], p_index[var1][val1], SPURIOUS);
                 }
             }
         }
@@ -311,16 +311,7 @@ bool H2Mutexes::initialize(const vector <Variable *> &variables,
 
 bool H2Mutexes::init_values_progression(const vector <Variable *> &variables,
                                         const State &initial_state) {
-    int countSpurious = 0, countReached = 0, countNotReached = 0;
-
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == SPURIOUS) {
-            countSpurious++;
-            continue;
-        }
-        m_values[i] = NOT_REACHED;
-        countNotReached++;
-    }
+    fill(reached_pairs.begin(), reached_pairs.end(), 0);
 
     for (unsigned i = 0; i < variables.size(); i++) {
         int var1 = variables[i]->get_level();
@@ -328,18 +319,18 @@ bool H2Mutexes::init_values_progression(const vector <Variable *> &variables,
         for (unsigned j = 0; j < variables.size(); j++) {
             int var2 = variables[j]->get_level();
             unsigned fluent2 = p_index[var2][initial_state[variables[j]]];
-            unsigned pos = position(fluent1, fluent2);
-            if (m_values[pos] == SPURIOUS)
+            Reachability value = get_value(fluent1, fluent2);
+            if (value == SPURIOUS)
                 return false;
             //This check probably is unnecessary, because the initial state should not contain anything spurious
             // (I left it just in case of unsolvable problems)
-            if (m_values[pos] == NOT_REACHED) {
-                m_values[pos] = REACHED;
-                countReached++;
-                countNotReached--;
+            if (value == NOT_REACHED) {
+                set_value(fluent1, fluent2, REACHED);
             }
         }
     }
+    int countSpurious = 0, countReached = 0, countNotReached = 0;
+    count_pairs(countReached, countNotReached, countSpurious);
     cout << "Initialized mvalues forward: reached=" << countReached <<
         ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
 
@@ -355,8 +346,7 @@ bool H2Mutexes::check_initial_state_is_dead_end(const vector <Variable *> &varia
         for (unsigned j = 0; j < variables.size(); j++) {
             int var2 = variables[j]->get_level();
             unsigned fluent2 = p_index[var2][initial_state[variables[j]]];
-            unsigned pos = position(fluent1, fluent2);
-            if (m_values[pos] == SPURIOUS) {
+            if (get_value(fluent1, fluent2) == SPURIOUS) {
                 return true;
             }
         }
@@ -373,8 +363,7 @@ bool H2Mutexes::check_goal_state_is_unreachable(const vector<pair<Variable *, in
             int var2 = goal[g2].first->get_level();
             unsigned fluent2 = p_index[var2][goal[g2].second];
 
-            unsigned pos = position(fluent1, fluent2);
-            if (m_values[pos] == SPURIOUS) {
+            if (get_value(fluent1, fluent2) == SPURIOUS) {
                 return true;
             }
         }
@@ -390,10 +379,14 @@ bool H2Mutexes::init_values_regression(const vector<pair<Variable *, int>> &goal
     if (check_goal_state_is_unreachable(goal))
         return false;
 
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] != SPURIOUS) {
-            m_values[i] = REACHED;
-        }
+    // Everything that is not spurious is reached. Keep the padding bits zero.
+    uint64_t last_word_mask = ~uint64_t(0);
+    if (number_props % BITS_PER_WORD != 0)
+        last_word_mask = bit_mask(number_props) - 1;
+    for (size_t word = 0; word < reached_pairs.size(); ++word) {
+        reached_pairs[word] = ~spurious_pairs[word];
+        if (word % words_per_row == words_per_row - 1)
+            reached_pairs[word] &= last_word_mask;
     }
 
     // the things that are mutex with the goal are not reached
@@ -414,15 +407,7 @@ bool H2Mutexes::init_values_regression(const vector<pair<Variable *, int>> &goal
     }
 
     int countSpurious = 0, countReached = 0, countNotReached = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == REACHED) {
-            countReached++;
-        } else if (m_values[i] == NOT_REACHED) {
-            countNotReached++;
-        } else {
-            countSpurious++;
-        }
-    }
+    count_pairs(countReached, countNotReached, countSpurious);
 
     cout << "Initialized mvalues backward: reached=" << countReached <<
         ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
@@ -431,21 +416,29 @@ bool H2Mutexes::init_values_regression(const vector<pair<Variable *, int>> &goal
 }
 
 void H2Mutexes::setPropositionNotReached(int prop_index) {
-    for (int var2 = 0; var2 < num_vars; var2++) {
-        for (int val2 = 0; val2 < num_vals[var2]; val2++) {
-            int p_index_2 = p_index[var2][val2];
-            int pos1 = position(prop_index, p_index_2);
-            if (m_values[pos1] == REACHED) {
-                m_values[pos1] = NOT_REACHED;
-            }
-            int pos2 = position(p_index_2, prop_index);
-            if (m_values[pos2] == REACHED) {
-                m_values[pos2] = NOT_REACHED;
-            }
-        }
+    // Reached pairs in the row and column of the proposition become not reached.
+    size_t row_start = word_index(prop_index, 0);
+    fill(reached_pairs.begin() + row_start,
+         reached_pairs.begin() + row_start + words_per_row, 0);
+    uint64_t mask = ~bit_mask(prop_index);
+    for (unsigned prop = 0; prop < number_props; ++prop) {
+        reached_pairs[word_index(prop, prop_index)] &= mask;
     }
 }
 
+void H2Mutexes::count_pairs(int &num_reached, int &num_not_reached,
+                            int &num_spurious) const {
+    num_reached = 0;
+    num_spurious = 0;
+    for (size_t word = 0; word < reached_pairs.size(); ++word) {
+        for (uint64_t bits = reached_pairs[word]; bits; bits &= bits - 1)
+            ++num_reached;
+        for (uint64_t bits = spurious_pairs[word]; bits; bits &= bits - 1)
+            ++num_spurious;
+    }
+    num_not_reached = number_props * number_props - num_reached - num_spurious;
+}
+
 void H2Mutexes::init_h2_operators(const vector<Operator> &operators, const vector<Axiom> &axioms, bool regression) {
     m_ops.clear();
     m_ops.reserve(operators.size());
@@ -481,6 +474,14 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
 
     cout << "Computing mutexes..." << endl;
 
+    // Bit set of the propositions p with a reached pair (p, p).
+    vector<uint64_t> reached_props(words_per_row, 0);
+    for (unsigned prop = 0; prop < number_props; ++prop) {
+        if (get_value(prop, prop) == REACHED)
+            reached_props[prop / BITS_PER_WORD] |= bit_mask(prop);
+    }
+    vector<uint64_t> candidates(words_per_row);
+
     bool updated;
     do {
         // if (time_exceeded())
@@ -491,54 +492,60 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
             if (op_i % 10000 == 0 && time_exceeded())
                 return TIMEOUT;
 
+            Op_h2 &op = m_ops[op_i];
             // disregard spurious operators
-            if (m_ops[op_i].triggered == SPURIOUS)
+            if (op.triggered == SPURIOUS)
                 continue;
 
             // if the preconditions haven't been met, continue
-            if ((m_ops[op_i].triggered != REACHED) &&
-                ((m_ops[op_i].triggered =
-                      eval_propositions(m_ops[op_i].pre)) != REACHED))
+            if ((op.triggered != REACHED) &&
+                ((op.triggered = eval_propositions(op.pre)) != REACHED))
                 continue;
 
-
-            for (unsigned add_i = 0; add_i < m_ops[op_i].add.size(); add_i++) {
-                unsigned p = m_ops[op_i].add[add_i];
-                for (unsigned add_j = 0; add_j < m_ops[op_i].add.size(); add_j++) {
-                    unsigned q = m_ops[op_i].add[add_j];
-                    if (m_values[position(p, q)] == NOT_REACHED) {
-                        m_values[position(p, q)] = m_values[position(q, p)] = REACHED;
+            for (unsigned p : op.add) {
+                for (unsigned q : op.add) {
+                    if (get_value(p, q) == NOT_REACHED) {
+                        set_value(p, q, REACHED);
+                        set_value(q, p, REACHED);
+                        if (p == q)
+                            reached_props[p / BITS_PER_WORD] |= bit_mask(p);
                         updated = true;
                     }
                 }
+            }
+            if (op.add.empty())
+                continue;
 
-
-                for (unsigned prop_i = 0; prop_i < number_props; prop_i++) {
-                    if (m_values[position(prop_i, prop_i)] != REACHED ||
-                        m_values[position(p, prop_i)] != NOT_REACHED)
-                        continue;
-
-                    if (binary_search(m_ops[op_i].add.begin(),
-                                      m_ops[op_i].add.end(),
-                                      prop_i) ||
-                        binary_search(m_ops[op_i].del.begin(),
-                                      m_ops[op_i].del.end(),
-                                      prop_i)) {
-                        continue;
-                    }
-
-                    bool satisfied = true;
-                    for (unsigned pre_i = 0; satisfied && pre_i < m_ops[op_i].pre.size(); pre_i++) {
-                        satisfied = (m_values[position(prop_i, m_ops[op_i].pre[pre_i])] == REACHED);
-                    }
-
-                    if (satisfied) {
-                        // pair<unsigned, unsigned> a = p_index_reverse[prop_i];
-                        // pair<unsigned, unsigned> b = p_index_reverse[p];
-                        // cout << "Action: " << g_operators[op_i].get_name() << " -> ";
-                        // cout << print_fluent(a.first,a.second) << " - " << print_fluent(b.first,b.second) << endl;
-                        m_values[position(p, prop_i)] = m_values[position(prop_i, p)] = REACHED;
-                        updated = true;
+            /*
+              An add p can be reached together with every reached proposition
+              that the operator neither adds nor deletes and that is reached
+              together with all preconditions. Since the table is symmetric,
+              we can intersect the rows of the preconditions word by word.
+            */
+            candidates = reached_props;
+            for (unsigned pre : op.pre) {
+                const uint64_t *row = &reached_pairs[word_index(pre, 0)];
+                for (unsigned word = 0; word < words_per_row; ++word)
+                    candidates[word] &= row[word];
+            }
+            for (unsigned prop : op.add)
+                candidates[prop / BITS_PER_WORD] &= ~bit_mask(prop);
+            for (unsigned prop : op.del)
+                candidates[prop / BITS_PER_WORD] &= ~bit_mask(prop);
+
+            for (unsigned p : op.add) {
+                size_t row_start = word_index(p, 0);
+                for (unsigned word = 0; word < words_per_row; ++word) {
+                    uint64_t new_pairs = candidates[word] &
+                        ~(reached_pairs[row_start + word] |
+                          spurious_pairs[row_start + word]);
+                    for (unsigned bit = 0; new_pairs; ++bit, new_pairs >>= 1) {
+                        if (new_pairs & 1) {
+                            unsigned prop = word * BITS_PER_WORD + bit;
+                            set_value(p, prop, REACHED);
+                            set_value(prop, p, REACHED);
+                            updated = true;
+                        }
                     }
                 }
             }
@@ -546,15 +553,7 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
     } while (updated);
 
     int countReached = 0, countNotReached = 0, countSpurious = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == REACHED) {
-            countReached++;
-        } else if (m_values[i] == NOT_REACHED) {
-            countNotReached++;
-        } else {
-            countSpurious++;
-        }
-    }
+    count_pairs(countReached, countNotReached, countSpurious);
     cout << "Mutex computation finished with reached=" << countReached <<
         ", notReached=" << countNotReached << ", spurious=" << countSpurious << endl;
 
@@ -571,11 +570,21 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
     //Add mutexes
     unsigned count = 0;
     int countUnreachable = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == NOT_REACHED) {
-            m_values[i] = SPURIOUS;
-            pair<unsigned, unsigned> a = p_index_reverse[i / number_props];
-            pair<unsigned, unsigned> b = p_index_reverse[i % number_props];
+    for (unsigned i = 0; i < number_props; i++) {
+        for (unsigned j = 0; j < number_props; j++) {
+            // Skip words without unreached pairs.
+            if (j % BITS_PER_WORD == 0) {
+                size_t word = word_index(i, j);
+                if (!~(reached_pairs[word] | spurious_pairs[word])) {
+                    j += BITS_PER_WORD - 1;
+                    continue;
+                }
+            }
+            if (get_value(i, j) != NOT_REACHED)
+                continue;
+            set_value(i, j, SPURIOUS);
+            pair<unsigned, unsigned> a = p_index_reverse[i];
+            pair<unsigned, unsigned> b = p_index_reverse[j];
             if (a == b) {
                 if (!is_unreachable(a.first, a.second)) {
                     countUnreachable++;
@@ -584,8 +593,7 @@ int H2Mutexes::compute(const vector <Variable *> &variables,
                     }
                 }
             } else {
-                if (m_values[position(p_index[a.first][a.second], p_index[a.first][a.second])] == REACHED &&
-                    m_values[position(p_index[b.first][b.second], p_index[b.first][b.second])] == REACHED) {
+                if (get_value(i, i) == REACHED && get_value(j, j) == REACHED) {
                     // cout << "Mutex: " << variables[a.first]->get_fact_name(a.second) << " and "
                     //      << variables[b.first]->get_fact_name(b.second) << endl;
                     //Only increase the mutex count when both fluents are reachable
@@ -627,24 +635,26 @@ Reachability H2Mutexes::eval_propositions(const vector<unsigned> &props) {
         return REACHED;
     for (unsigned i = 0; i < props.size(); i++)
         for (unsigned j = i; j < props.size(); j++)
-            if (m_values[position(props[i], props[j])] == NOT_REACHED)
+            if (get_value(props[i], props[j]) == NOT_REACHED)
                 return NOT_REACHED;
     return REACHED;
 }
 
 void H2Mutexes::print_mutexes(const vector <Variable *> &variables) {
     unsigned count = 0;
-    for (unsigned i = 0; i < m_values.size(); i++) {
-        if (m_values[i] == SPURIOUS) {
-            pair<unsigned, unsigned> a = p_index_reverse[i / number_props];
-            pair<unsigned, unsigned> b = p_index_reverse[i % number_props];
-            if (!are_mutex(a.first, a.second, b.first, b.second)) {
-                count++;
-                cout << variables[a.first]->get_fact_name(a.second) << " - " << variables[b.first]->get_fact_name(b.second) << endl;
+    for (unsigned i = 0; i < number_props; i++) {
+        for (unsigned j = 0; j < number_props; j++) {
+            if (get_value(i, j) == SPURIOUS) {
+                pair<unsigned, unsigned> a = p_index_reverse[i];
+                pair<unsigned, unsigned> b = p_index_reverse[j];
+                if (!are_mutex(a.first, a.second, b.first, b.second)) {
+                    count++;
+                    cout << variables[a.first]->get_fact_name(a.second) << " - " << variables[b.first]->get_fact_name(b.second) << endl;
+                }
             }
         }
     }
-    cout << count << " " << m_values.size() << endl;
+    cout << count << " " << number_props * number_props << endl;
 }
 
 void H2Mutexes::print_pair(unsigned /*pair*/) {
@@ -3,6 +3,7 @@
 #ifndef H2_MUTEXES_H
 #define H2_MUTEXES_H
 
+#include <cstdint>
 #include <ctime>
 #include <iostream>
 #include <algorithm>
@@ -85,7 +86,7 @@ public:
             return val1 != val2;  //TODO: || unreachable[var1][val1];
         unsigned p1 = p_index[var1][val1];
         unsigned p2 = p_index[var2][val2];
-        return m_values[position(p1, p2)] == SPURIOUS;
+        return get_value(p1, p2) == SPURIOUS;
     }
 
     inline int num_variables() const {
@@ -120,7 +121,16 @@ protected:
     std::vector<std::vector<std::set<std::pair<int, int>>>> inconsistent_facts;
 
     unsigned number_props;
-    vector<unsigned> m_values;
+    /*
+      The reachability of all pairs of propositions is stored in two bit
+      matrices with one row of words_per_row words per proposition. A pair
+      is REACHED or SPURIOUS if its bit is set in the corresponding matrix
+      and NOT_REACHED if it is set in neither. The table is symmetric and
+      the padding bits at the end of each row are always zero.
+    */
+    unsigned words_per_row;
+    vector<uint64_t> reached_pairs;
+    vector<uint64_t> spurious_pairs;
     vector<Op_h2> m_ops;
 
     vector< vector<unsigned>> p_index;
@@ -128,10 +138,40 @@ protected:
 
     Reachability eval_propositions(const vector<unsigned> & props);
 
-    inline unsigned position(unsigned a, unsigned b) const {
-        return (a * number_props) + b;
+    static const unsigned BITS_PER_WORD = 64;
+
+    inline static uint64_t bit_mask(unsigned prop) {
+        return uint64_t(1) << (prop % BITS_PER_WORD);
+    }
+
+    inline size_t word_index(unsigned a, unsigned b) const {
+        return static_cast<size_t>(a) * words_per_row + b / BITS_PER_WORD;
+    }
+
+    inline Reachability get_value(unsigned a, unsigned b) const {
+        size_t word = word_index(a, b);
+        uint64_t mask = bit_mask(b);
+        if (reached_pairs[word] & mask)
+            return REACHED;
+        if (spurious_pairs[word] & mask)
+            return SPURIOUS;
+        return NOT_REACHED;
+    }
+
+    inline void set_value(unsigned a, unsigned b, Reachability value) {
+        size_t word = word_index(a, b);
+        uint64_t mask = bit_mask(b);
+        reached_pairs[word] &= ~mask;
+        spurious_pairs[word] &= ~mask;
+        if (value == REACHED)
+            reached_pairs[word] |= mask;
+        else if (value == SPURIOUS)
+            spurious_pairs[word] |= mask;
     }
 
+    void count_pairs(int &num_reached, int &num_not_reached,
+                     int &num_spurious) const;
+
     bool set_unreachable(int var, int val, const vector <Variable *> &variables, 
 			 const State &initial_state, 
 			 const vector<pair<Variable *, int>> &goal); 
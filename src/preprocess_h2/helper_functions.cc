@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
 #include <cstdlib>
 #include <iostream>
 #include <fstream>
@@ -18,6 +21,11 @@ using namespace std;
 static const int SAS_FILE_VERSION = 3;
 static const int PRE_FILE_VERSION = SAS_FILE_VERSION;
 
+// Keep in sync with search/tasks/binary_root_task.cc, which describes the layout.
+static const char BINARY_TASK_MAGIC[8] = {'\x7f', 'F', 'D', 'T', 'A', 'S', 'K', '\n'};
+static const int32_t BINARY_TASK_BYTE_ORDER_MARK = 0x01020304;
+static const int32_t BINARY_TASK_VERSION = 1;
+
 
 void check_magic(istream &in, string magic) {
     string word;
@@ -202,6 +210,208 @@ void generate_cpp_input(const vector<Variable *> &ordered_vars,
 
     outfile.close();
 }
+static void write_ints(ofstream &outfile, const vector<int32_t> &values) {
+    outfile.write(reinterpret_cast<const char *>(values.data()),
+                  values.size() * sizeof(int32_t));
+}
+
+static void append_fact(vector<int32_t> &facts, const Variable *var, int value) {
+    assert(var->get_level() != -1);
+    facts.push_back(var->get_level());
+    facts.push_back(value);
+}
+
+class BinaryStrings {
+    vector<int32_t> offsets;
+    string data;
+public:
+    BinaryStrings() : offsets(1, 0) {}
+
+    int add(const string &str) {
+        data += str;
+        offsets.push_back(data.size());
+        return offsets.size() - 2;
+    }
+
+    int size() const {
+        return offsets.size() - 1;
+    }
+
+    int get_data_size() const {
+        return data.size();
+    }
+
+    void write(ofstream &outfile) const {
+        write_ints(outfile, offsets);
+        outfile.write(data.data(), data.size());
+    }
+};
+
+/*
+  Operators or axioms in the binary format. Each action and each effect
+  stores the index of its first precondition, effect or effect condition,
+  so the actions end with a sentinel entry.
+*/
+class BinaryActions {
+    int num_actions;
+    vector<int32_t> actions;
+    vector<int32_t> preconditions;
+    vector<int32_t> effects;
+    vector<int32_t> conditions;
+public:
+    BinaryActions() : num_actions(0) {}
+
+    void start_action(int cost, int name) {
+        ++num_actions;
+        actions.push_back(preconditions.size() / 2);
+        actions.push_back(effects.size() / 3);
+        actions.push_back(cost);
+        actions.push_back(name);
+    }
+
+    void add_precondition(const Variable *var, int value) {
+        append_fact(preconditions, var, value);
+    }
+
+    void start_effect(const Variable *var, int value) {
+        append_fact(effects, var, value);
+        effects.push_back(conditions.size() / 2);
+    }
+
+    void add_effect_condition(const Variable *var, int value) {
+        append_fact(conditions, var, value);
+    }
+
+    void write(ofstream &outfile) const {
+        int num_preconditions = preconditions.size() / 2;
+        int num_effects = effects.size() / 3;
+        int num_conditions = conditions.size() / 2;
+        write_ints(outfile, {num_actions, num_preconditions, num_effects, num_conditions});
+        write_ints(outfile, actions);
+        write_ints(outfile, {num_preconditions, num_effects, 0, -1});
+        write_ints(outfile, preconditions);
+        write_ints(outfile, effects);
+        write_ints(outfile, {-1, -1, num_conditions});
+        write_ints(outfile, conditions);
+    }
+};
+
+void generate_binary_cpp_input(const vector<Variable *> &ordered_vars,
+                               const bool &metric,
+                               const vector<MutexGroup> &mutexes,
+                               const State &initial_state,
+                               const vector<pair<Variable *, int>> &goals,
+                               const vector<Operator> &operators,
+                               const vector<Axiom> &axioms) {
+    int num_vars = ordered_vars.size();
+    BinaryStrings strings;
+    vector<int32_t> variables;
+    vector<int> fact_offsets;
+    int num_facts = 0;
+    for (Variable *var : ordered_vars) {
+        fact_offsets.push_back(num_facts);
+        variables.push_back(strings.add(var->get_name()));
+        variables.push_back(var->get_layer());
+        int domain_size = 0;
+        int first_fact_name = strings.size();
+        for (int value = 0; value < var->get_range(); ++value) {
+            if (var->is_reachable(value)) {
+                strings.add(var->get_fact_name(value));
+                ++domain_size;
+            }
+        }
+        variables.push_back(domain_size);
+        variables.push_back(first_fact_name);
+        num_facts += domain_size;
+    }
+
+    vector<int32_t> initial_state_values;
+    for (Variable *var : ordered_vars)
+        initial_state_values.push_back(initial_state[var]);
+
+    // The search needs the sorted mutex partners of each fact.
+    vector<vector<pair<int, int>>> inconsistent_facts(num_facts);
+    for (const MutexGroup &mutex : mutexes) {
+        for (const auto &fact1 : mutex.getFacts()) {
+            for (const auto &fact2 : mutex.getFacts()) {
+                int var1 = fact1.first->get_level();
+                int var2 = fact2.first->get_level();
+                if (var1 != var2) {
+                    inconsistent_facts[fact_offsets[var1] + fact1.second].push_back(
+                        make_pair(var2, fact2.second));
+                }
+            }
+        }
+    }
+    vector<int32_t> mutex_offsets;
+    vector<int32_t> mutex_facts;
+    for (vector<pair<int, int>> &partners : inconsistent_facts) {
+        sort(partners.begin(), partners.end());
+        partners.erase(unique(partners.begin(), partners.end()), partners.end());
+        mutex_offsets.push_back(mutex_facts.size() / 2);
+        for (const pair<int, int> &fact : partners) {
+            mutex_facts.push_back(fact.first);
+            mutex_facts.push_back(fact.second);
+        }
+    }
+    mutex_offsets.push_back(mutex_facts.size() / 2);
+
+    vector<int> ordered_goal_values(num_vars, -1);
+    for (const auto &goal : goals)
+        ordered_goal_values[goal.first->get_level()] = goal.second;
+    vector<int32_t> goal_facts;
+    for (int i = 0; i < num_vars; i++) {
+        if (ordered_goal_values[i] != -1) {
+            goal_facts.push_back(i);
+            goal_facts.push_back(ordered_goal_values[i]);
+        }
+    }
+
+    BinaryActions binary_operators;
+    for (const Operator &op : operators) {
+        binary_operators.start_action(op.get_cost(), strings.add(op.get_name()));
+        for (const auto &prev : op.get_prevail())
+            binary_operators.add_precondition(prev.var, prev.prev);
+        for (const auto &eff : op.get_pre_post()) {
+            if (eff.pre != -1)
+                binary_operators.add_precondition(eff.var, eff.pre);
+        }
+        for (const auto &eff : op.get_pre_post()) {
+            binary_operators.start_effect(eff.var, eff.post);
+            for (const auto &cond : eff.effect_conds)
+                binary_operators.add_effect_condition(cond.var, cond.cond);
+        }
+    }
+
+    BinaryActions binary_axioms;
+    for (const Axiom &axiom : axioms) {
+        binary_axioms.start_action(0, -1);
+        if (axiom.get_old_val() != -1)
+            binary_axioms.add_precondition(axiom.get_effect_var(), axiom.get_old_val());
+        binary_axioms.start_effect(axiom.get_effect_var(), axiom.get_effect_val());
+        for (const Axiom::Condition &condition : axiom.get_conditions())
+            binary_axioms.add_effect_condition(condition.var, condition.cond);
+    }
+
+    ofstream outfile;
+    outfile.open("output.sas", ios::out | ios::binary);
+    outfile.write(BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC));
+    write_ints(outfile, {BINARY_TASK_BYTE_ORDER_MARK, BINARY_TASK_VERSION,
+                         metric, num_vars, num_facts,
+                         static_cast<int32_t>(mutex_facts.size() / 2),
+                         static_cast<int32_t>(goal_facts.size() / 2),
+                         strings.size(), strings.get_data_size()});
+    write_ints(outfile, variables);
+    write_ints(outfile, initial_state_values);
+    write_ints(outfile, mutex_offsets);
+    write_ints(outfile, mutex_facts);
+    write_ints(outfile, goal_facts);
+    binary_operators.write(outfile);
+    binary_axioms.write(outfile);
+    strings.write(outfile);
+    outfile.close();
+}
+
 void generate_unsolvable_cpp_input() {
     ofstream outfile;
     outfile.open("output.sas", ios::out);
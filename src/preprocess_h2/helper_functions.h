@@ -41,6 +41,14 @@ void generate_cpp_input(const vector<Variable *> &ordered_var,
                         const vector<pair<Variable *, int>> &goals,
                         const vector<Operator> &operators,
                         const vector<Axiom> &axioms);
+// Write the task in the binary format read by the search component.
+void generate_binary_cpp_input(const vector<Variable *> &ordered_var,
+                               const bool &metric,
+                               const vector<MutexGroup> &mutexes,
+                               const State &initial_state,
+                               const vector<pair<Variable *, int>> &goals,
+                               const vector<Operator> &operators,
+                               const vector<Axiom> &axioms);
 void check_magic(istream & in, string magic);
 
 #endif
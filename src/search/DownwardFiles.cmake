@@ -74,6 +74,7 @@ fast_downward_plugin(
         search_progress
         search_space
         search_statistics
+        search_telemetry
         state_id
         state_registry
         task_id
@@ -113,9 +114,11 @@ fast_downward_plugin(
         utils/hash
         utils/language
         utils/logging
+        utils/mapped_file
         utils/markup
         utils/math
         utils/memory
+        utils/profiling
         utils/rng
         utils/rng_options
         utils/strings
@@ -147,11 +150,20 @@ fast_downward_plugin(
         open_lists/epsilon_greedy_open_list
 )
 
+fast_downward_plugin(
+    NAME OPEN_LIST_KEY
+    HELP "Evaluator values used as keys in open lists"
+    SOURCES
+        open_lists/open_list_key
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME PARETO_OPEN_LIST
     HELP "Pareto open list"
     SOURCES
         open_lists/pareto_open_list
+    DEPENDS OPEN_LIST_KEY
 )
 
 fast_downward_plugin(
@@ -159,6 +171,7 @@ fast_downward_plugin(
     HELP "Tiebreaking open list"
     SOURCES
         open_lists/tiebreaking_open_list
+    DEPENDS OPEN_LIST_KEY
 )
 
 fast_downward_plugin(
@@ -166,6 +179,7 @@ fast_downward_plugin(
     HELP "Type-based open list"
     SOURCES
         open_lists/type_based_open_list
+    DEPENDS OPEN_LIST_KEY
 )
 
 fast_downward_plugin(
@@ -458,11 +472,28 @@ fast_downward_plugin(
     DEPENDS G_EVALUATOR ORDERED_SET PREF_EVALUATOR SEARCH_COMMON SUCCESSOR_GENERATOR
 )
 
+fast_downward_plugin(
+    NAME SEARCH_ENGINE_FACTORY
+    HELP "Creation of search engines that share states and evaluators"
+    SOURCES
+        search_engines/search_engine_factory
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME ITERATED_SEARCH
     HELP "Iterated search algorithm"
     SOURCES
         search_engines/iterated_search
+    DEPENDS SEARCH_ENGINE_FACTORY
+)
+
+fast_downward_plugin(
+    NAME PORTFOLIO_SEARCH
+    HELP "In-process portfolio of search algorithms"
+    SOURCES
+        search_engines/portfolio_search
+    DEPENDS SEARCH_ENGINE_FACTORY
 )
 
 fast_downward_plugin(
@@ -553,7 +584,7 @@ fast_downward_plugin(
     HELP "The h^m heuristic"
     SOURCES
         heuristics/hm_heuristic
-    DEPENDS TASK_PROPERTIES
+    DEPENDS FACT_TUPLE_INDEX PRIORITY_QUEUES TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -577,6 +608,7 @@ fast_downward_plugin(
     NAME CORE_TASKS
     HELP "Core task transformations"
     SOURCES
+        tasks/binary_root_task
         tasks/cost_adapted_task
         tasks/delegating_task
         tasks/root_task
@@ -604,6 +636,14 @@ fast_downward_plugin(
     DEPENDENCY_ONLY
 )
 
+fast_downward_plugin(
+    NAME FACT_TUPLE_INDEX
+    HELP "Dense indices for sets of facts"
+    SOURCES
+        task_utils/fact_tuple_index
+    DEPENDENCY_ONLY
+)
+
 fast_downward_plugin(
     NAME SAMPLING
     HELP "Sampling"
@@ -767,7 +807,7 @@ fast_downward_plugin(
         landmarks/landmark_graph
         landmarks/landmark_status_manager
         landmarks/util
-    DEPENDS LP_SOLVER PRIORITY_QUEUES SUCCESSOR_GENERATOR TASK_PROPERTIES
+    DEPENDS FACT_TUPLE_INDEX LP_SOLVER PRIORITY_QUEUES SUCCESSOR_GENERATOR TASK_PROPERTIES
 )
 
 fast_downward_plugin(
@@ -112,6 +112,11 @@ public:
         return the_size;
     }
 
+    size_t estimate_memory_in_bytes() const {
+        return segments.size() * SEGMENT_ELEMENTS * sizeof(Entry) +
+               segments.capacity() * sizeof(Entry *);
+    }
+
     void push_back(const Entry &entry) {
         size_t segment = get_segment(the_size);
         size_t offset = get_offset(the_size);
@@ -230,6 +235,11 @@ public:
         return the_size;
     }
 
+    size_t estimate_memory_in_bytes() const {
+        return segments.size() * elements_per_segment * sizeof(Element) +
+               segments.capacity() * sizeof(Element *);
+    }
+
     void push_back(const Element *entry) {
         size_t segment = get_segment(the_size);
         size_t offset = get_offset(the_size);
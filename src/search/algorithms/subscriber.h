@@ -1,8 +1,13 @@
 #ifndef ALGORITHMS_SUBSCRIBER_H
 #define ALGORITHMS_SUBSCRIBER_H
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <string>
 #include <unordered_set>
+#include <utility>
+#include <vector>
 
 /*
   The classes in this file allow objects of one class to react to the
@@ -50,6 +55,19 @@ class Subscriber {
     std::unordered_set<const SubscriberService<T> *> services;
     virtual void notify_service_destroyed(const T *) = 0;
 public:
+    /*
+      Subscribers that store data for the services they subscribe to can
+      report the memory they use for the given service. The name identifies
+      the subscriber in such reports.
+    */
+    virtual size_t estimate_memory_in_bytes(const T *) const {
+        return 0;
+    }
+
+    virtual std::string get_name() const {
+        return "unnamed";
+    }
+
     virtual ~Subscriber() {
         /*
           We have to copy the services because unsubscribing erases the
@@ -100,6 +118,28 @@ public:
         assert(subscriber->services.find(this) != subscriber->services.end());
         subscriber->services.erase(this);
     }
+
+    /*
+      Return the names and memory estimates of all subscribers, ordered by
+      decreasing memory usage.
+    */
+    std::vector<std::pair<std::string, size_t>>
+    estimate_subscriber_memory_in_bytes() const {
+        std::vector<std::pair<std::string, size_t>> memory;
+        memory.reserve(subscribers.size());
+        for (const Subscriber<T> *subscriber : subscribers) {
+            memory.emplace_back(
+                subscriber->get_name(),
+                subscriber->estimate_memory_in_bytes(static_cast<const T *>(this)));
+        }
+        std::sort(memory.begin(), memory.end(),
+                  [](const std::pair<std::string, size_t> &lhs,
+                     const std::pair<std::string, size_t> &rhs) {
+                      return lhs.second > rhs.second ||
+                      (lhs.second == rhs.second && lhs.first < rhs.first);
+                  });
+        return memory;
+    }
 };
 }
 #endif
@@ -0,0 +1,434 @@
+#include "../evaluation_context.h"
+#include "../evaluator.h"
+#include "../open_list_factory.h"
+#include "../option_parser.h"
+#include "../per_state_information.h"
+#include "../state_registry.h"
+#include "../task_proxy.h"
+
+#include "../cost_saturation/abstraction.h"
+#include "../cost_saturation/abstraction_generator.h"
+#include "../cost_saturation/types.h"
+#include "../cost_saturation/utils.h"
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+#include "../task_utils/successor_generator.h"
+#include "../task_utils/task_properties.h"
+#include "../tasks/root_task.h"
+#include "../utils/rng.h"
+#include "../utils/system.h"
+#include "../utils/timer.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+using utils::ExitCode;
+
+/*
+  Measure the throughput of the hot paths of the search on a fixed task:
+  successor generation, state registration, open-list insertion and
+  removal, goal distance computations in the scp abstractions, and the
+  evaluation of the scp, lmcut and ff heuristics.
+
+  All benchmarks work on the same states, which are sampled with random
+  walks from the initial state using a fixed seed. Each benchmark runs
+  several times and we report the fastest run. The checksum summarizes
+  the computed results (e.g., the sum of heuristic values) and must not
+  change between builds unless the semantics of the code changes.
+
+  Each benchmark reports its result on one line that starts with "task="
+  and contains fixed keys, so that results of different builds can be
+  compared automatically. The evaluators may log additional lines while
+  they are initialized.
+*/
+
+static const int RANDOM_SEED = 2023;
+static const int MAX_WALK_LENGTH = 50;
+static const int NUM_SUCCESSOR_GENERATIONS = 100000;
+static const int NUM_OPEN_LIST_ENTRIES = 100000;
+static const int NUM_DISTANCE_COMPUTATIONS = 10000;
+static const int NUM_TRANSITION_EVALUATIONS = 1000;
+
+struct Sample {
+    State state;
+    int g;
+};
+
+struct RunResult {
+    int64_t operations;
+    int64_t checksum;
+};
+
+static vector<Sample> sample_states(
+    StateRegistry &registry, const TaskProxy &task_proxy,
+    const successor_generator::SuccessorGenerator &successor_generator,
+    int num_samples, utils::RandomNumberGenerator &rng) {
+    OperatorsProxy operators = task_proxy.get_operators();
+    vector<Sample> samples;
+    samples.reserve(num_samples);
+    vector<OperatorID> applicable_ops;
+    for (int i = 0; i < num_samples; ++i) {
+        State state = registry.get_initial_state();
+        int g = 0;
+        int length = rng.random(MAX_WALK_LENGTH + 1);
+        for (int step = 0; step < length; ++step) {
+            applicable_ops.clear();
+            successor_generator.generate_applicable_ops(state, applicable_ops);
+            if (applicable_ops.empty()) {
+                break;
+            }
+            OperatorProxy op = operators[*rng.choose(applicable_ops)];
+            state = registry.get_successor_state(state, op);
+            g += op.get_cost();
+        }
+        /* If the last state is a duplicate, its buffer lies in the popped
+           slot of the state data pool, which later registrations reuse. */
+        samples.push_back({registry.lookup_state(state.get_id()), g});
+    }
+    return samples;
+}
+
+template<typename Function>
+static void run_benchmark(
+    const string &task_name, const string &benchmark_name,
+    int repetitions, const Function &run) {
+    double best_time = numeric_limits<double>::max();
+    RunResult result = {0, 0};
+    for (int i = 0; i < repetitions; ++i) {
+        utils::Timer timer;
+        RunResult run_result = run();
+        double time = timer.stop();
+        if (i > 0 && (run_result.operations != result.operations ||
+                      run_result.checksum != result.checksum)) {
+            cerr << "Benchmark " << benchmark_name
+                 << " computed different results in different runs." << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+        result = run_result;
+        best_time = min(best_time, time);
+    }
+    cout << fixed << setprecision(6)
+         << "task=" << task_name
+         << " benchmark=" << benchmark_name
+         << " operations=" << result.operations
+         << " checksum=" << result.checksum
+         << " time=" << best_time
+         << " operations_per_second="
+         << setprecision(0) << result.operations / max(best_time, 1e-9)
+         << endl;
+}
+
+static string get_task_name(const string &path) {
+    size_t start = path.find_last_of("/\\");
+    start = (start == string::npos) ? 0 : start + 1;
+    size_t end = path.rfind(".sas");
+    if (end == string::npos || end < start) {
+        end = path.size();
+    }
+    return path.substr(start, end - start);
+}
+
+static void benchmark_successor_generation(
+    const string &task_name, int repetitions, const vector<Sample> &samples,
+    const successor_generator::SuccessorGenerator &successor_generator) {
+    run_benchmark(
+        task_name, "successor_generation", repetitions, [&]() {
+            RunResult result = {NUM_SUCCESSOR_GENERATIONS, 0};
+            vector<OperatorID> applicable_ops;
+            for (int i = 0; i < NUM_SUCCESSOR_GENERATIONS; ++i) {
+                applicable_ops.clear();
+                successor_generator.generate_applicable_ops(
+                    samples[i % samples.size()].state, applicable_ops);
+                result.checksum += applicable_ops.size();
+            }
+            return result;
+        });
+}
+
+static void benchmark_state_registration(
+    const string &task_name, int repetitions, const TaskProxy &task_proxy,
+    const vector<Sample> &samples,
+    const successor_generator::SuccessorGenerator &successor_generator) {
+    // Compute the transitions outside of the measured code.
+    vector<pair<int, OperatorID>> transitions;
+    vector<OperatorID> applicable_ops;
+    for (size_t i = 0; i < samples.size(); ++i) {
+        applicable_ops.clear();
+        successor_generator.generate_applicable_ops(
+            samples[i].state, applicable_ops);
+        for (OperatorID op_id : applicable_ops) {
+            transitions.emplace_back(i, op_id);
+        }
+    }
+    OperatorsProxy operators = task_proxy.get_operators();
+    run_benchmark(
+        task_name, "state_registration", repetitions, [&]() {
+            StateRegistry registry(task_proxy);
+            for (const pair<int, OperatorID> &transition : transitions) {
+                registry.get_successor_state(
+                    samples[transition.first].state,
+                    operators[transition.second]);
+            }
+            RunResult result = {
+                static_cast<int64_t>(transitions.size()),
+                static_cast<int64_t>(registry.size())};
+            return result;
+        });
+}
+
+static void benchmark_open_list(
+    const string &task_name, int repetitions, const vector<Sample> &samples,
+    const StateRegistry &state_registry, options::Registry &registry,
+    const options::Predefinitions &predefinitions) {
+    // The open list of astar(blind()).
+    OptionParser parser(
+        "tiebreaking([sum([g(), blind()]), blind()])",
+        registry, predefinitions, false);
+    shared_ptr<OpenListFactory> factory =
+        parser.start_parsing<shared_ptr<OpenListFactory>>();
+    // Summarize the removal order by the g values of the removed states.
+    PerStateInformation<int> g_values;
+    for (const Sample &sample : samples) {
+        g_values[sample.state] = sample.g;
+    }
+    run_benchmark(
+        task_name, "open_list", repetitions, [&]() {
+            unique_ptr<StateOpenList> open_list =
+                factory->create_state_open_list();
+            RunResult result = {2 * NUM_OPEN_LIST_ENTRIES, 0};
+            for (int i = 0; i < NUM_OPEN_LIST_ENTRIES; ++i) {
+                const Sample &sample = samples[i % samples.size()];
+                EvaluationContext eval_context(
+                    sample.state, sample.g, false, nullptr);
+                open_list->insert(eval_context, sample.state.get_id());
+            }
+            for (int i = 0; i < NUM_OPEN_LIST_ENTRIES; ++i) {
+                State state = state_registry.lookup_state(
+                    open_list->remove_min());
+                result.checksum += static_cast<int64_t>(i % 1000) *
+                    g_values[state];
+            }
+            return result;
+        });
+}
+
+/*
+  Saturate the costs of the abstractions of the scp benchmark one after the
+  other, like the computation of a cost partitioning for an order does. We
+  start over with the original costs after each pass.
+*/
+static void benchmark_goal_distances(
+    const string &task_name, int repetitions, const TaskProxy &task_proxy,
+    options::Registry &registry,
+    const options::Predefinitions &predefinitions) {
+    OptionParser parser(
+        "[projections(systematic(2), verbosity=silent), "
+        "cartesian(verbosity=silent)]",
+        registry, predefinitions, false);
+    vector<shared_ptr<cost_saturation::AbstractionGenerator>> generators =
+        parser.start_parsing<
+            vector<shared_ptr<cost_saturation::AbstractionGenerator>>>();
+    cost_saturation::Abstractions abstractions =
+        cost_saturation::generate_abstractions(
+            tasks::g_root_task, generators, nullptr);
+    vector<int> costs = task_properties::get_operator_costs(task_proxy);
+    run_benchmark(
+        task_name, "goal_distances", repetitions, [&]() {
+            RunResult result = {NUM_DISTANCE_COMPUTATIONS, 0};
+            vector<int> remaining_costs = costs;
+            for (int i = 0; i < NUM_DISTANCE_COMPUTATIONS; ++i) {
+                int abstraction_id = i % abstractions.size();
+                if (abstraction_id == 0) {
+                    remaining_costs = costs;
+                }
+                const cost_saturation::Abstraction &abstraction =
+                    *abstractions[abstraction_id];
+                vector<int> h_values =
+                    abstraction.compute_goal_distances(remaining_costs);
+                for (int h : h_values) {
+                    result.checksum += (h == cost_saturation::INF) ? -1 : h;
+                }
+                vector<int> saturated_costs =
+                    abstraction.compute_saturated_costs(h_values);
+                cost_saturation::reduce_costs(remaining_costs, saturated_costs);
+            }
+            return result;
+        });
+}
+
+static void benchmark_evaluator(
+    const string &task_name, const string &name, const string &config,
+    int repetitions, const vector<Sample> &samples,
+    options::Registry &registry,
+    const options::Predefinitions &predefinitions) {
+    OptionParser parser(config, registry, predefinitions, false);
+    shared_ptr<Evaluator> evaluator =
+        parser.start_parsing<shared_ptr<Evaluator>>();
+    run_benchmark(
+        task_name, name, repetitions, [&]() {
+            RunResult result = {static_cast<int64_t>(samples.size()), 0};
+            for (const Sample &sample : samples) {
+                EvaluationContext eval_context(sample.state);
+                int h = eval_context.get_evaluator_value_or_infinity(
+                    evaluator.get());
+                // Count dead ends with a fixed value.
+                result.checksum += (h == EvaluationResult::INFTY) ? -1 : h;
+            }
+            return result;
+        });
+}
+
+/*
+  Evaluate the samples and their successors in the order in which a search
+  expands them. This lets path-dependent evaluators such as
+  lmcut(incremental=true) reuse information of the parents. We stop after
+  NUM_TRANSITION_EVALUATIONS evaluations. Each run uses a fresh evaluator,
+  so that no information carries over between runs.
+*/
+static void benchmark_evaluator_on_transitions(
+    const string &task_name, const string &name, const string &config,
+    int repetitions, const TaskProxy &task_proxy,
+    StateRegistry &state_registry, const vector<Sample> &samples,
+    const successor_generator::SuccessorGenerator &successor_generator,
+    options::Registry &registry,
+    const options::Predefinitions &predefinitions) {
+    // Create the evaluators outside of the measured code.
+    vector<shared_ptr<Evaluator>> evaluators;
+    for (int i = 0; i < repetitions; ++i) {
+        OptionParser parser(config, registry, predefinitions, false);
+        evaluators.push_back(parser.start_parsing<shared_ptr<Evaluator>>());
+    }
+    OperatorsProxy operators = task_proxy.get_operators();
+    int run = 0;
+    run_benchmark(
+        task_name, name, repetitions, [&]() {
+            Evaluator *evaluator = evaluators[run++].get();
+            set<Evaluator *> path_dependent_evaluators;
+            evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+            RunResult result = {0, 0};
+            vector<OperatorID> applicable_ops;
+            for (const Sample &sample : samples) {
+                if (result.operations >= NUM_TRANSITION_EVALUATIONS) {
+                    break;
+                }
+                EvaluationContext parent_context(sample.state);
+                int parent_h = parent_context.get_evaluator_value_or_infinity(
+                    evaluator);
+                ++result.operations;
+                if (parent_h == EvaluationResult::INFTY) {
+                    --result.checksum;
+                    continue;
+                }
+                result.checksum += parent_h;
+                applicable_ops.clear();
+                successor_generator.generate_applicable_ops(
+                    sample.state, applicable_ops);
+                for (OperatorID op_id : applicable_ops) {
+                    if (result.operations >= NUM_TRANSITION_EVALUATIONS) {
+                        break;
+                    }
+                    State succ = state_registry.get_successor_state(
+                        sample.state, operators[op_id]);
+                    for (Evaluator *path_dependent : path_dependent_evaluators) {
+                        path_dependent->notify_state_transition(
+                            sample.state, op_id, succ);
+                    }
+                    EvaluationContext eval_context(succ);
+                    int h = eval_context.get_evaluator_value_or_infinity(
+                        evaluator);
+                    ++result.operations;
+                    result.checksum += (h == EvaluationResult::INFTY) ? -1 : h;
+                }
+            }
+            return result;
+        });
+}
+
+int main(int argc, const char **argv) {
+    utils::register_event_handlers();
+
+    if (argc < 2 || argc > 4) {
+        cerr << "usage: " << argv[0]
+             << " TASK.sas [NUM_SAMPLES [NUM_REPETITIONS]]" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    string task_path = argv[1];
+    int num_samples = (argc > 2) ? stoi(argv[2]) : 1000;
+    int repetitions = (argc > 3) ? stoi(argv[3]) : 3;
+    if (num_samples < 1 || repetitions < 1) {
+        cerr << "number of samples and repetitions must be positive" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    ifstream task_file(task_path);
+    if (!task_file) {
+        cerr << "Failed to open task file: " << task_path << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    tasks::read_root_task(task_file);
+    TaskProxy task_proxy(*tasks::g_root_task);
+    string task_name = get_task_name(task_path);
+
+    const successor_generator::SuccessorGenerator &successor_generator =
+        successor_generator::g_successor_generators[task_proxy];
+    StateRegistry state_registry(task_proxy);
+    utils::RandomNumberGenerator rng(RANDOM_SEED);
+    vector<Sample> samples = sample_states(
+        state_registry, task_proxy, successor_generator, num_samples, rng);
+
+    options::Registry registry(*options::RawRegistry::instance());
+    options::Predefinitions predefinitions;
+
+    benchmark_successor_generation(
+        task_name, repetitions, samples, successor_generator);
+    benchmark_state_registration(
+        task_name, repetitions, task_proxy, samples, successor_generator);
+    benchmark_open_list(
+        task_name, repetitions, samples, state_registry, registry,
+        predefinitions);
+    benchmark_goal_distances(
+        task_name, repetitions, task_proxy, registry, predefinitions);
+    /*
+      We disable caching so that every run computes all estimates, and
+      compute scp orders without time limit to obtain the same heuristic
+      in every run.
+    */
+    benchmark_evaluator(
+        task_name, "scp",
+        "scp([projections(systematic(2)), cartesian()], max_orders=1, "
+        "max_time=infinity, diversify=false, max_optimization_time=0, "
+        "random_seed=0, "
+        "cache_estimates=false, verbosity=silent)",
+        repetitions, samples, registry, predefinitions);
+    benchmark_evaluator(
+        task_name, "lmcut", "lmcut(cache_estimates=false, verbosity=silent)",
+        repetitions, samples, registry, predefinitions);
+    /*
+      The plain and incremental versions of lmcut compute the same number
+      of estimates, but the incremental version may find other cuts, so the
+      checksums of the two benchmarks may differ.
+    */
+    benchmark_evaluator_on_transitions(
+        task_name, "lmcut_transitions",
+        "lmcut(cache_estimates=false, verbosity=silent)",
+        repetitions, task_proxy, state_registry, samples,
+        successor_generator, registry, predefinitions);
+    benchmark_evaluator_on_transitions(
+        task_name, "lmcut_incremental_transitions",
+        "lmcut(incremental=true, cache_estimates=false, verbosity=silent)",
+        repetitions, task_proxy, state_registry, samples,
+        successor_generator, registry, predefinitions);
+    benchmark_evaluator(
+        task_name, "ff", "ff(cache_estimates=false, verbosity=silent)",
+        repetitions, samples, registry, predefinitions);
+
+    return 0;
+}
@@ -127,8 +127,9 @@ void AbstractSearch::copy_h_value_to_children(int v, int v1, int v2) {
 }
 
 
-vector<int> compute_distances(
-    const vector<Transitions> &transitions,
+template<typename TransitionsByState>
+static vector<int> compute_distances_impl(
+    const TransitionsByState &transitions,
     const vector<int> &costs,
     const unordered_set<int> &start_ids) {
     vector<int> distances(transitions.size(), INF);
@@ -147,7 +148,7 @@ vector<int> compute_distances(
         assert(g <= old_g);
         if (g < old_g)
             continue;
-        assert(utils::in_bounds(state_id, transitions));
+        assert(state_id >= 0 && state_id < static_cast<int>(transitions.size()));
         for (const Transition &transition : transitions[state_id]) {
             const int op_cost = costs[transition.op_id];
             assert(op_cost >= 0);
@@ -162,4 +163,18 @@ vector<int> compute_distances(
     }
     return distances;
 }
+
+vector<int> compute_distances(
+    const vector<Transitions> &transitions,
+    const vector<int> &costs,
+    const unordered_set<int> &start_ids) {
+    return compute_distances_impl(transitions, costs, start_ids);
+}
+
+vector<int> compute_distances(
+    const array_pool_template::ArrayPool<Transition> &transitions,
+    const vector<int> &costs,
+    const unordered_set<int> &start_ids) {
+    return compute_distances_impl(transitions, costs, start_ids);
+}
 }
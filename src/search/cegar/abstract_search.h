@@ -4,6 +4,7 @@
 #include "transition.h"
 #include "types.h"
 
+#include "../algorithms/array_pool.h"
 #include "../algorithms/priority_queues.h"
 
 #include <memory>
@@ -78,6 +79,10 @@ extern std::vector<int> compute_distances(
     const std::vector<Transitions> &transitions,
     const std::vector<int> &costs,
     const std::unordered_set<int> &start_ids);
+extern std::vector<int> compute_distances(
+    const array_pool_template::ArrayPool<Transition> &transitions,
+    const std::vector<int> &costs,
+    const std::unordered_set<int> &start_ids);
 }
 
 #endif
@@ -61,6 +61,10 @@ unique_ptr<RefinementHierarchy> Abstraction::extract_refinement_hierarchy() {
     return move(refinement_hierarchy);
 }
 
+FrozenTransitionSystem Abstraction::extract_frozen_transition_system() {
+    return transition_system->freeze();
+}
+
 void Abstraction::mark_all_states_as_goals() {
     if (log.is_at_least_debug()) {
         log << "Mark all states as goals." << endl;
@@ -18,6 +18,7 @@ namespace cegar {
 class AbstractState;
 class RefinementHierarchy;
 class TransitionSystem;
+struct FrozenTransitionSystem;
 
 /*
   Store the set of AbstractStates, use AbstractSearch to find abstract
@@ -58,6 +59,9 @@ public:
     int get_abstract_state_id(const State &state) const;
     const TransitionSystem &get_transition_system() const;
     std::unique_ptr<RefinementHierarchy> extract_refinement_hierarchy();
+    /* Move the transitions into a compact read-only snapshot. Afterwards,
+       the abstraction must not be refined anymore. */
+    FrozenTransitionSystem extract_frozen_transition_system();
 
     /* Needed for CEGAR::separate_facts_unreachable_before_goal(). */
     void mark_all_states_as_goals();
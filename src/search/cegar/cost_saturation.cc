@@ -24,12 +24,12 @@ using namespace std;
 
 namespace cegar {
 static vector<int> compute_saturated_costs(
-    const TransitionSystem &transition_system,
+    const FrozenTransitionSystem &transition_system,
     const vector<int> &g_values,
     const vector<int> &h_values,
     bool use_general_costs) {
     const int min_cost = use_general_costs ? -INF : 0;
-    vector<int> saturated_costs(transition_system.get_num_operators(), min_cost);
+    vector<int> saturated_costs(transition_system.num_operators, min_cost);
     assert(g_values.size() == h_values.size());
     int num_states = h_values.size();
     for (int state_id = 0; state_id < num_states; ++state_id) {
@@ -47,8 +47,7 @@ static vector<int> compute_saturated_costs(
         if (g == INF || h == INF)
             continue;
 
-        for (const Transition &transition:
-             transition_system.get_outgoing_transitions()[state_id]) {
+        for (const Transition &transition : transition_system.outgoing[state_id]) {
             int op_id = transition.op_id;
             int succ_id = transition.target_id;
             int succ_h = h_values[succ_id];
@@ -63,7 +62,7 @@ static vector<int> compute_saturated_costs(
         if (use_general_costs) {
             /* To prevent negative cost cycles, all operators inducing
                self-loops must have non-negative costs. */
-            for (int op_id : transition_system.get_loops()[state_id]) {
+            for (int op_id : transition_system.loops[state_id]) {
                 saturated_costs[op_id] = max(saturated_costs[op_id], 0);
             }
         }
@@ -220,17 +219,19 @@ void CostSaturation::build_abstractions(
         num_non_looping_transitions += abstraction->get_transition_system().get_num_non_loops();
         assert(num_states <= max_states);
 
+        FrozenTransitionSystem transition_system =
+            abstraction->extract_frozen_transition_system();
         vector<int> costs = task_properties::get_operator_costs(TaskProxy(*subtask));
         vector<int> init_distances = compute_distances(
-            abstraction->get_transition_system().get_outgoing_transitions(),
+            transition_system.outgoing,
             costs,
             {abstraction->get_initial_state().get_id()});
         vector<int> goal_distances = compute_distances(
-            abstraction->get_transition_system().get_incoming_transitions(),
+            transition_system.incoming,
             costs,
             abstraction->get_goals());
         vector<int> saturated_costs = compute_saturated_costs(
-            abstraction->get_transition_system(),
+            transition_system,
             init_distances,
             goal_distances,
             use_general_costs);
@@ -18,6 +18,8 @@
 using namespace std;
 
 namespace cegar {
+const int FlawSearch::MISSING;
+
 int FlawSearch::get_abstract_state_id(const State &state) const {
     return abstraction.get_abstract_state_id(state);
 }
@@ -37,6 +39,16 @@ OptimalTransitions FlawSearch::get_f_optimal_transitions(int abstract_state_id)
     return transitions;
 }
 
+const OptimalTransitions &FlawSearch::get_cached_f_optimal_transitions(
+    int abstract_state_id) {
+    auto it = cached_f_optimal_transitions.find(abstract_state_id);
+    if (it == cached_f_optimal_transitions.end()) {
+        it = cached_f_optimal_transitions.emplace(
+            abstract_state_id, get_f_optimal_transitions(abstract_state_id)).first;
+    }
+    return it->second;
+}
+
 void FlawSearch::add_flaw(int abs_id, const State &state) {
     assert(abstraction.get_state(abs_id).includes(state));
 
@@ -78,9 +90,11 @@ void FlawSearch::initialize() {
     last_refined_flawed_state = FlawedState::no_state;
     best_flaw_h = (pick_flawed_abstract_state == PickFlawedAbstractState::MAX_H) ? 0 : INF_COSTS;
     assert(open_list.empty());
+    assert(cached_f_optimal_transitions.empty());
     state_registry = utils::make_unique_ptr<StateRegistry>(task_proxy);
     search_space = utils::make_unique_ptr<SearchSpace>(*state_registry, silent_log);
-    cached_abstract_state_ids = utils::make_unique_ptr<PerStateInformation<int>>(MISSING);
+    cached_abstract_state_ids = utils::make_unique_ptr<PerStateInformation<int>>(
+        MISSING, "cached_abstract_state_ids");
 
     assert(flawed_states.empty());
 
@@ -115,7 +129,7 @@ SearchStatus FlawSearch::step() {
     assert(abs_id == get_abstract_state_id(s));
 
     // Check for each transition if the operator is applicable or if there is a deviation.
-    for (auto &pair : get_f_optimal_transitions(abs_id)) {
+    for (auto &pair : get_cached_f_optimal_transitions(abs_id)) {
         if (!utils::extra_memory_padding_is_reserved()) {
             return TIMEOUT;
         }
@@ -399,6 +413,9 @@ SearchStatus FlawSearch::search_for_flaws(const utils::CountdownTimer &cegar_tim
     }
     // Clear open list.
     stack<StateID>().swap(open_list);
+    /* The cached transitions become invalid with the next refinement. Use
+       swap instead of clear() to release the memory. */
+    phmap::node_hash_map<int, OptimalTransitions>().swap(cached_f_optimal_transitions);
 
     int current_num_expanded_states = num_overall_expanded_concrete_states -
         num_expansions_in_prev_searches;
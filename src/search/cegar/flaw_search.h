@@ -69,6 +69,10 @@ class FlawSearch {
     std::unique_ptr<StateRegistry> state_registry;
     std::unique_ptr<SearchSpace> search_space;
     std::unique_ptr<PerStateInformation<int>> cached_abstract_state_ids;
+    /* The abstraction doesn't change during a flaw search, so we compute the
+       f-optimal transitions of each abstract state only once per search. We
+       use a node-based map since step() holds references into it. */
+    phmap::node_hash_map<int, OptimalTransitions> cached_f_optimal_transitions;
 
     // Flaw data
     FlawedState last_refined_flawed_state;
@@ -87,6 +91,7 @@ class FlawSearch {
     Cost get_h_value(int abstract_state_id) const;
     void add_flaw(int abs_id, const State &state);
     OptimalTransitions get_f_optimal_transitions(int abstract_state_id) const;
+    const OptimalTransitions &get_cached_f_optimal_transitions(int abstract_state_id);
 
     void initialize();
     SearchStatus step();
@@ -7,6 +7,7 @@
 #include "../task_proxy.h"
 
 #include "../task_utils/task_properties.h"
+#include "../utils/collections.h"
 #include "../utils/logging.h"
 
 #include <algorithm>
@@ -68,6 +69,19 @@ static int lookup_value(const vector<FactPair> &facts, int var) {
     return UNDEFINED;
 }
 
+template<typename T>
+static void move_into_pool(
+    vector<vector<T>> &vectors, array_pool_template::ArrayPool<T> &pool,
+    int num_entries) {
+    pool.reserve(vectors.size(), num_entries);
+    for (vector<T> &vec : vectors) {
+        sort(vec.begin(), vec.end());
+        pool.push_back(move(vec));
+        utils::release_vector_memory(vec);
+    }
+    utils::release_vector_memory(vectors);
+}
+
 static void remove_transitions_with_given_target(
     Transitions &transitions, int state_id) {
     auto new_end = remove_if(
@@ -355,4 +369,17 @@ void TransitionSystem::dump() const {
         cout << "  loops: " << loops[i] << endl;
     }
 }
+
+FrozenTransitionSystem TransitionSystem::freeze() {
+    FrozenTransitionSystem frozen;
+    frozen.num_operators = get_num_operators();
+    frozen.num_non_loops = num_non_loops;
+    frozen.num_loops = num_loops;
+    move_into_pool(incoming, frozen.incoming, num_non_loops);
+    move_into_pool(outgoing, frozen.outgoing, num_non_loops);
+    move_into_pool(loops, frozen.loops, num_loops);
+    num_non_loops = 0;
+    num_loops = 0;
+    return frozen;
+}
 }
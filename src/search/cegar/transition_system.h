@@ -1,8 +1,11 @@
 #ifndef CEGAR_TRANSITION_SYSTEM_H
 #define CEGAR_TRANSITION_SYSTEM_H
 
+#include "transition.h"
 #include "types.h"
 
+#include "../algorithms/array_pool.h"
+
 #include <vector>
 
 struct FactPair;
@@ -13,6 +16,26 @@ class LogProxy;
 }
 
 namespace cegar {
+/*
+  Read-only snapshot of a TransitionSystem in compressed sparse row format.
+  The transitions and self-loops of each state are stored contiguously and
+  are sorted by operator ID, which makes the snapshot well suited for the
+  read-only phases after refinement (distance and saturated cost
+  computations).
+*/
+struct FrozenTransitionSystem {
+    array_pool_template::ArrayPool<Transition> incoming;
+    array_pool_template::ArrayPool<Transition> outgoing;
+    array_pool_template::ArrayPool<int> loops;
+    int num_operators;
+    int num_non_loops;
+    int num_loops;
+
+    int get_num_states() const {
+        return outgoing.size();
+    }
+};
+
 /*
   Rewire transitions after each split.
 */
@@ -72,6 +95,17 @@ public:
 
     void print_statistics(utils::LogProxy &log) const;
     void dump() const;
+
+    /*
+      Move all transitions into a FrozenTransitionSystem. We build the pools
+      for incoming transitions, outgoing transitions and loops one after the
+      other. Each pool is allocated completely before the per-state vectors
+      are copied into it and released one by one, while the vectors of the
+      other kinds are still alive. The peak memory usage is therefore about
+      1.5 times the memory needed for all transitions. Afterwards, this
+      transition system is empty and must not be used anymore.
+    */
+    FrozenTransitionSystem freeze();
 };
 }
 
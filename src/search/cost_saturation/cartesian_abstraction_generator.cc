@@ -38,15 +38,15 @@ public:
 
 
 static vector<bool> get_looping_operators(
-    const cegar::TransitionSystem &ts, const vector<int> &h_values) {
-    assert(ts.get_loops().size() == h_values.size());
+    const cegar::FrozenTransitionSystem &ts, const vector<int> &h_values) {
+    assert(ts.loops.size() == static_cast<int>(h_values.size()));
     int num_states = h_values.size();
-    int num_operators = ts.get_num_operators();
+    int num_operators = ts.num_operators;
     vector<bool> operator_induces_self_loop(num_operators, false);
     for (int state = 0; state < num_states; ++state) {
         // Ignore self-loops at unsolvable states.
         if (h_values[state] != INF) {
-            for (int op_id : ts.get_loops()[state]) {
+            for (int op_id : ts.loops[state]) {
                 operator_induces_self_loop[op_id] = true;
             }
         }
@@ -57,13 +57,14 @@ static vector<bool> get_looping_operators(
 
 static pair<bool, unique_ptr<Abstraction>> convert_abstraction(
     cegar::Abstraction &cartesian_abstraction,
-    const vector<int> &operator_costs) {
+    const vector<int> &operator_costs,
+    BackwardGraphStore &graph_store) {
     // Compute h values.
-    const cegar::TransitionSystem &ts =
-        cartesian_abstraction.get_transition_system();
+    const cegar::FrozenTransitionSystem ts =
+        cartesian_abstraction.extract_frozen_transition_system();
     int initial_state_id = cartesian_abstraction.get_initial_state().get_id();
     vector<int> h_values = cegar::compute_distances(
-        ts.get_incoming_transitions(), operator_costs, cartesian_abstraction.get_goals());
+        ts.incoming, operator_costs, cartesian_abstraction.get_goals());
 
     // Retrieve non-looping transitions.
     vector<vector<Successor>> backward_graph(cartesian_abstraction.get_num_states());
@@ -72,7 +73,7 @@ static pair<bool, unique_ptr<Abstraction>> convert_abstraction(
         if (h_values[target] == INF) {
             continue;
         }
-        for (const cegar::Transition &transition : ts.get_incoming_transitions()[target]) {
+        for (const cegar::Transition &transition : ts.incoming[target]) {
             int src = transition.target_id;
             // Prune transitions *from* unsolvable states.
             if (h_values[src] == INF) {
@@ -96,7 +97,8 @@ static pair<bool, unique_ptr<Abstraction>> convert_abstraction(
                        cartesian_abstraction.extract_refinement_hierarchy()),
                    move(backward_graph),
                    move(looping_operators),
-                   move(goal_states))
+                   move(goal_states),
+                   graph_store)
     };
 }
 
@@ -157,6 +159,7 @@ unique_ptr<cegar::Abstraction> CartesianAbstractionGenerator::build_abstraction_
 void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
     const vector<shared_ptr<AbstractTask>> &subtasks,
     const utils::CountdownTimer &timer,
+    BackwardGraphStore &graph_store,
     Abstractions &abstractions) {
     int remaining_subtasks = subtasks.size();
     for (const shared_ptr<AbstractTask> &subtask : subtasks) {
@@ -173,7 +176,8 @@ void CartesianAbstractionGenerator::build_abstractions_for_subtasks(
         num_transitions += cartesian_abstraction->get_transition_system().get_num_non_loops();
 
         vector<int> operator_costs = task_properties::get_operator_costs(TaskProxy(*subtask));
-        auto result = convert_abstraction(*cartesian_abstraction, operator_costs);
+        auto result = convert_abstraction(
+            *cartesian_abstraction, operator_costs, graph_store);
         bool unsolvable = result.first;
         abstractions.push_back(move(result.second));
 
@@ -196,10 +200,11 @@ Abstractions CartesianAbstractionGenerator::generate_abstractions(
     // The CEGAR code expects that some extra memory is reserved.
     utils::reserve_extra_memory_padding(extra_memory_padding_mb);
 
+    BackwardGraphStore graph_store;
     Abstractions abstractions;
     for (const auto &subtask_generator : subtask_generators) {
         cegar::SharedTasks subtasks = subtask_generator->get_subtasks(task, log);
-        build_abstractions_for_subtasks(subtasks, timer, abstractions);
+        build_abstractions_for_subtasks(subtasks, timer, graph_store, abstractions);
         if (has_reached_resource_limit(timer)) {
             break;
         }
@@ -215,6 +220,7 @@ Abstractions CartesianAbstractionGenerator::generate_abstractions(
     log << "Total number of Cartesian states: " << num_states << endl;
     log << "Total number of transitions in Cartesian abstractions: "
         << num_transitions << endl;
+    graph_store.print_statistics(log);
     return abstractions;
 }
 
@@ -25,6 +25,8 @@ class RandomNumberGenerator;
 }
 
 namespace cost_saturation {
+class BackwardGraphStore;
+
 class CartesianAbstractionGenerator : public AbstractionGenerator {
     const std::vector<std::shared_ptr<cegar::SubtaskGenerator>> subtask_generators;
     const int max_states;
@@ -53,6 +55,7 @@ class CartesianAbstractionGenerator : public AbstractionGenerator {
     void build_abstractions_for_subtasks(
         const std::vector<std::shared_ptr<AbstractTask>> &subtasks,
         const utils::CountdownTimer &timer,
+        BackwardGraphStore &graph_store,
         Abstractions &abstractions);
 
 public:
@@ -3,16 +3,20 @@
 #include "types.h"
 
 #include "../utils/collections.h"
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 #include "../utils/strings.h"
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_set>
+#include <utility>
 
 using namespace std;
 
 namespace cost_saturation {
 static void dijkstra_search(
-    const vector<vector<Successor>> &graph,
+    const BackwardGraph &graph,
     const vector<int> &costs,
     priority_queues::AdaptiveQueue<int> &queue,
     vector<int> &distances) {
@@ -42,39 +46,260 @@ static void dijkstra_search(
     }
 }
 
+/*
+  Breadth-first search for the case where all labels cost either "cost" or
+  INF. The queue must initially contain the start states.
+*/
+static void breadth_first_search(
+    const BackwardGraph &graph,
+    const vector<int> &costs,
+    int cost,
+    vector<int> &queue,
+    vector<int> &distances) {
+    assert(cost >= 0 && cost != INF);
+    for (size_t i = 0; i < queue.size(); ++i) {
+        int state = queue[i];
+        int successor_distance = distances[state] + cost;
+        assert(successor_distance >= 0);
+        for (const Successor &transition : graph[state]) {
+            int successor = transition.state;
+            assert(utils::in_bounds(transition.op, costs));
+            assert(costs[transition.op] == cost || costs[transition.op] == INF);
+            if (distances[successor] == INF && costs[transition.op] != INF) {
+                distances[successor] = successor_distance;
+                queue.push_back(successor);
+            }
+        }
+    }
+}
+
+/*
+  Return c if all given costs are c or INF, INF if all costs are INF, and -1
+  otherwise.
+*/
+static int get_uniform_cost(const vector<int> &costs) {
+    int uniform_cost = INF;
+    for (int cost : costs) {
+        if (cost != INF) {
+            if (uniform_cost == INF) {
+                uniform_cost = cost;
+            } else if (cost != uniform_cost) {
+                return -1;
+            }
+        }
+    }
+    return uniform_cost;
+}
+
 ostream &operator<<(ostream &os, const Successor &successor) {
     os << "(" << successor.op << ", " << successor.state << ")";
     return os;
 }
 
-static vector<bool> get_active_operators_from_graph(
-    const vector<vector<Successor>> &backward_graph, int num_ops) {
-    vector<bool> active_operators(num_ops, false);
-    int num_states = backward_graph.size();
+/*
+  Group operators inducing the same transitions into labels and return the
+  backward graph over labels.
+
+  To avoid storing the transitions of each operator separately, we group
+  operators by the number and a hash of their transitions. In a second pass
+  over the graph, we check that each operator induces the same transitions
+  as the first operator of its group. (Only hash collisions make this check
+  fail, and then the operator gets a label of its own.) Labels are ordered
+  by the numbers and hashes of their transitions, so the result only
+  depends on the transition system and not on the operator IDs.
+*/
+static BackwardGraph compute_label_graph(
+    vector<vector<Successor>> &&graph, int num_operators,
+    array_pool_template::ArrayPool<int> &label_to_operators) {
+    int num_states = graph.size();
+    /* Sorting the transitions of each target by operator lets us feed the
+       transitions of each operator into its hash in a fixed order. */
+    vector<utils::HashState> hash_states(num_operators);
+    vector<int> num_transitions(num_operators, 0);
     for (int target = 0; target < num_states; ++target) {
-        for (const Successor &transition : backward_graph[target]) {
-            int op_id = transition.op;
-            active_operators[op_id] = true;
+        vector<Successor> &transitions = graph[target];
+        sort(transitions.begin(), transitions.end());
+        for (const Successor &transition : transitions) {
+            utils::feed(hash_states[transition.op], target);
+            utils::feed(hash_states[transition.op], transition.state);
+            ++num_transitions[transition.op];
+        }
+    }
+
+    vector<int> active_operators;
+    vector<uint64_t> hashes(num_operators, 0);
+    for (int op_id = 0; op_id < num_operators; ++op_id) {
+        if (num_transitions[op_id] > 0) {
+            hashes[op_id] = hash_states[op_id].get_hash64();
+            active_operators.push_back(op_id);
+        }
+    }
+    utils::release_vector_memory(hash_states);
+    auto get_key = [&num_transitions, &hashes](int op_id) {
+                       return make_pair(num_transitions[op_id], hashes[op_id]);
+                   };
+    // Use a stable sort to keep the operators of each group sorted by ID.
+    stable_sort(active_operators.begin(), active_operators.end(),
+                [&get_key](int op1, int op2) {
+                    return get_key(op1) < get_key(op2);
+                });
+
+    vector<int> representative(num_operators, -1);
+    for (size_t i = 0; i < active_operators.size(); ++i) {
+        int op_id = active_operators[i];
+        if (i > 0 && get_key(op_id) == get_key(active_operators[i - 1])) {
+            representative[op_id] = representative[active_operators[i - 1]];
+        } else {
+            representative[op_id] = op_id;
+        }
+    }
+
+    /* Since an operator and its representative induce the same number of
+       transitions, they induce the same transitions if the representative
+       induces all transitions of the operator. */
+    vector<int> first_transition(num_operators, -1);
+    for (int target = 0; target < num_states; ++target) {
+        const vector<Successor> &transitions = graph[target];
+        int num_target_transitions = transitions.size();
+        for (int i = 0; i < num_target_transitions; ++i) {
+            if (i == 0 || transitions[i].op != transitions[i - 1].op) {
+                first_transition[transitions[i].op] = i;
+            }
+        }
+        for (int i = 0; i < num_target_transitions; ++i) {
+            int op_id = transitions[i].op;
+            int rep = representative[op_id];
+            if (rep == op_id) {
+                continue;
+            }
+            int rep_i = first_transition[rep];
+            int op_i = first_transition[op_id];
+            bool found = (rep_i != -1);
+            if (found) {
+                // Compare the i-th transition with the corresponding one of rep.
+                int j = rep_i + (i - op_i);
+                found = j < num_target_transitions && transitions[j].op == rep &&
+                    transitions[j].state == transitions[i].state;
+            }
+            if (!found) {
+                representative[op_id] = op_id;
+            }
+        }
+        for (const Successor &transition : transitions) {
+            first_transition[transition.op] = -1;
+        }
+    }
+    utils::release_vector_memory(first_transition);
+
+    vector<int> operator_to_label(num_operators, -1);
+    vector<vector<int>> operators_by_label;
+    int num_label_transitions = 0;
+    for (int op_id : active_operators) {
+        int rep = representative[op_id];
+        if (rep == op_id) {
+            operator_to_label[op_id] = operators_by_label.size();
+            operators_by_label.emplace_back();
+            num_label_transitions += num_transitions[op_id];
+        }
+        operators_by_label[operator_to_label[rep]].push_back(op_id);
+    }
+    for (vector<int> &operators : operators_by_label) {
+        label_to_operators.push_back(move(operators));
+    }
+
+    /* Keep the transitions of the representatives and store them
+       contiguously, sorted by label for compute_saturated_costs(). */
+    BackwardGraph label_graph;
+    label_graph.reserve(num_states, num_label_transitions);
+    vector<Successor> label_transitions;
+    for (vector<Successor> &transitions : graph) {
+        label_transitions.clear();
+        for (const Successor &transition : transitions) {
+            if (representative[transition.op] == transition.op) {
+                label_transitions.emplace_back(
+                    operator_to_label[transition.op], transition.state);
+            }
+        }
+        utils::release_vector_memory(transitions);
+        sort(label_transitions.begin(), label_transitions.end());
+        // Only the elements are moved, so we can reuse the vector.
+        label_graph.push_back(move(label_transitions));
+    }
+    return label_graph;
+}
+
+static size_t get_hash(const BackwardGraph &graph) {
+    utils::HashState hash_state;
+    utils::feed(hash_state, graph.size());
+    for (int state = 0; state < graph.size(); ++state) {
+        auto transitions = graph[state];
+        utils::feed(hash_state, static_cast<int>(
+                        distance(transitions.begin(), transitions.end())));
+        for (const Successor &transition : transitions) {
+            utils::feed(hash_state, transition.op);
+            utils::feed(hash_state, transition.state);
+        }
+    }
+    return hash_state.get_hash64();
+}
+
+static bool graphs_are_equal(const BackwardGraph &graph1, const BackwardGraph &graph2) {
+    if (graph1.size() != graph2.size()) {
+        return false;
+    }
+    for (int state = 0; state < graph1.size(); ++state) {
+        auto transitions1 = graph1[state];
+        auto transitions2 = graph2[state];
+        if (distance(transitions1.begin(), transitions1.end()) !=
+            distance(transitions2.begin(), transitions2.end()) ||
+            !equal(transitions1.begin(), transitions1.end(), transitions2.begin())) {
+            return false;
         }
     }
-    return active_operators;
+    return true;
 }
 
+
+BackwardGraphStore::BackwardGraphStore()
+    : num_requests(0),
+      num_reused_graphs(0) {
+}
+
+shared_ptr<const BackwardGraph> BackwardGraphStore::insert(BackwardGraph &&graph) {
+    ++num_requests;
+    vector<shared_ptr<const BackwardGraph>> &candidates = graphs_by_hash[get_hash(graph)];
+    for (const shared_ptr<const BackwardGraph> &candidate : candidates) {
+        if (graphs_are_equal(*candidate, graph)) {
+            ++num_reused_graphs;
+            return candidate;
+        }
+    }
+    candidates.push_back(make_shared<const BackwardGraph>(move(graph)));
+    return candidates.back();
+}
+
+void BackwardGraphStore::print_statistics(utils::LogProxy &log) const {
+    if (log.is_at_least_normal()) {
+        log << "Distinct transition systems: "
+            << num_requests - num_reused_graphs << "/" << num_requests << endl;
+    }
+}
+
+
 ExplicitAbstraction::ExplicitAbstraction(
     unique_ptr<AbstractionFunction> abstraction_function,
     vector<vector<Successor>> &&backward_graph_,
     vector<bool> &&looping_operators,
-    vector<int> &&goal_states)
+    vector<int> &&goal_states,
+    BackwardGraphStore &graph_store)
     : Abstraction(move(abstraction_function)),
-      backward_graph(move(backward_graph_)),
-      active_operators(get_active_operators_from_graph(
-                           backward_graph, looping_operators.size())),
+      active_operators(looping_operators.size(), false),
       looping_operators(move(looping_operators)),
       goal_states(move(goal_states)) {
 #ifndef NDEBUG
-    for (int target = 0; target < get_num_states(); ++target) {
+    for (int target = 0; target < static_cast<int>(backward_graph_.size()); ++target) {
         // Check that no transition is stored multiple times.
-        vector<Successor> copied_transitions = this->backward_graph[target];
+        vector<Successor> copied_transitions = backward_graph_[target];
         sort(copied_transitions.begin(), copied_transitions.end());
         assert(utils::is_sorted_unique(copied_transitions));
         // Check that we don't store self-loops.
@@ -82,21 +307,91 @@ ExplicitAbstraction::ExplicitAbstraction(
                       [target](const Successor &succ) {return succ.state != target;}));
     }
 #endif
+    backward_graph = graph_store.insert(
+        compute_label_graph(
+            move(backward_graph_), get_num_operators(), label_to_operators));
+    for (int label = 0; label < label_to_operators.size(); ++label) {
+        for (int op_id : label_to_operators[label]) {
+            active_operators[op_id] = true;
+        }
+    }
+}
+
+void ExplicitAbstraction::compute_label_costs(const vector<int> &costs) const {
+    int num_labels = label_to_operators.size();
+    label_costs.resize(num_labels);
+    for (int label = 0; label < num_labels; ++label) {
+        int min_cost = INF;
+        for (int op_id : label_to_operators[label]) {
+            min_cost = min(min_cost, costs[op_id]);
+        }
+        label_costs[label] = min_cost;
+    }
 }
 
 vector<int> ExplicitAbstraction::compute_goal_distances(const vector<int> &costs) const {
+    assert(static_cast<int>(costs.size()) == get_num_operators());
+    compute_label_costs(costs);
     vector<int> goal_distances(get_num_states(), INF);
-    queue.clear();
-    for (int goal_state : goal_states) {
-        goal_distances[goal_state] = 0;
-        queue.push(0, goal_state);
+    int uniform_cost = get_uniform_cost(label_costs);
+    if (uniform_cost == INF) {
+        // There are no finite-cost state-changing transitions.
+        for (int goal_state : goal_states) {
+            goal_distances[goal_state] = 0;
+        }
+    } else if (uniform_cost >= 0) {
+        fifo_queue.clear();
+        for (int goal_state : goal_states) {
+            goal_distances[goal_state] = 0;
+            fifo_queue.push_back(goal_state);
+        }
+        breadth_first_search(
+            *backward_graph, label_costs, uniform_cost, fifo_queue, goal_distances);
+    } else {
+        queue.clear();
+        for (int goal_state : goal_states) {
+            goal_distances[goal_state] = 0;
+            queue.push(0, goal_state);
+        }
+        dijkstra_search(*backward_graph, label_costs, queue, goal_distances);
     }
-    dijkstra_search(backward_graph, costs, queue, goal_distances);
     return goal_distances;
 }
 
 vector<int> ExplicitAbstraction::compute_saturated_costs(
     const vector<int> &h_values) const {
+    int num_labels = label_to_operators.size();
+    vector<int> saturated_label_costs(num_labels, -INF);
+
+    int num_states = get_num_states();
+    for (int target = 0; target < num_states; ++target) {
+        assert(utils::in_bounds(target, h_values));
+        int target_h = h_values[target];
+        if (target_h == INF) {
+            continue;
+        }
+
+        auto transitions = (*backward_graph)[target];
+        auto it = transitions.begin();
+        auto end = transitions.end();
+        while (it != end) {
+            // Find the maximum h value of the sources of the current label.
+            int label = it->op;
+            int max_src_h = -INF;
+            for (; it != end && it->op == label; ++it) {
+                assert(utils::in_bounds(it->state, h_values));
+                int src_h = h_values[it->state];
+                if (src_h != INF) {
+                    max_src_h = max(max_src_h, src_h);
+                }
+            }
+            if (max_src_h != -INF) {
+                const int needed = max_src_h - target_h;
+                saturated_label_costs[label] = max(saturated_label_costs[label], needed);
+            }
+        }
+    }
+
     int num_operators = get_num_operators();
     vector<int> saturated_costs(num_operators, -INF);
 
@@ -108,25 +403,10 @@ vector<int> ExplicitAbstraction::compute_saturated_costs(
         }
     }
 
-    int num_states = backward_graph.size();
-    for (int target = 0; target < num_states; ++target) {
-        assert(utils::in_bounds(target, h_values));
-        int target_h = h_values[target];
-        if (target_h == INF) {
-            continue;
-        }
-
-        for (const Successor &transition : backward_graph[target]) {
-            int op_id = transition.op;
-            int src = transition.state;
-            assert(utils::in_bounds(src, h_values));
-            int src_h = h_values[src];
-            if (src_h == INF) {
-                continue;
-            }
-
-            const int needed = src_h - target_h;
-            saturated_costs[op_id] = max(saturated_costs[op_id], needed);
+    for (int label = 0; label < num_labels; ++label) {
+        int saturated_label_cost = saturated_label_costs[label];
+        for (int op_id : label_to_operators[label]) {
+            saturated_costs[op_id] = max(saturated_costs[op_id], saturated_label_cost);
         }
     }
     return saturated_costs;
@@ -137,7 +417,7 @@ int ExplicitAbstraction::get_num_operators() const {
 }
 
 int ExplicitAbstraction::get_num_states() const {
-    return backward_graph.size();
+    return backward_graph->size();
 }
 
 bool ExplicitAbstraction::operator_is_active(int op_id) const {
@@ -151,10 +431,11 @@ bool ExplicitAbstraction::operator_induces_self_loop(int op_id) const {
 void ExplicitAbstraction::for_each_transition(const TransitionCallback &callback) const {
     int num_states = get_num_states();
     for (int target = 0; target < num_states; ++target) {
-        for (const Successor &transition : backward_graph[target]) {
-            int op_id = transition.op;
+        for (const Successor &transition : (*backward_graph)[target]) {
             int src = transition.state;
-            callback(Transition(src, op_id, target));
+            for (int op_id : label_to_operators[transition.op]) {
+                callback(Transition(src, op_id, target));
+            }
         }
     }
 }
@@ -172,6 +453,7 @@ void ExplicitAbstraction::dump() const {
          << count(active_operators.begin(), active_operators.end(), true) << endl;
     cout << "Operators inducing self-loops: "
          << count(looping_operators.begin(), looping_operators.end(), true) << endl;
+    cout << "Labels: " << label_to_operators.size() << endl;
 
     vector<bool> is_goal(num_states, false);
     for (int goal : goal_states) {
@@ -186,9 +468,11 @@ void ExplicitAbstraction::dump() const {
     }
     for (int target = 0; target < num_states; ++target) {
         unordered_map<int, vector<int>> parallel_transitions;
-        for (const Successor &succ : backward_graph[target]) {
+        for (const Successor &succ : (*backward_graph)[target]) {
             int src = succ.state;
-            parallel_transitions[src].push_back(succ.op);
+            for (int op_id : label_to_operators[succ.op]) {
+                parallel_transitions[src].push_back(op_id);
+            }
         }
         for (const auto &pair : parallel_transitions) {
             int src = pair.first;
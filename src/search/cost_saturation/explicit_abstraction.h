@@ -3,12 +3,18 @@
 
 #include "abstraction.h"
 
+#include "../algorithms/array_pool.h"
 #include "../algorithms/priority_queues.h"
 
 #include <memory>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+namespace utils {
+class LogProxy;
+}
+
 namespace cost_saturation {
 struct Successor {
     int op;
@@ -19,6 +25,10 @@ struct Successor {
           state(state) {
     }
 
+    bool operator==(const Successor &other) const {
+        return op == other.op && state == other.state;
+    }
+
     bool operator<(const Successor &other) const {
         return std::make_pair(op, state) < std::make_pair(other.op, other.state);
     }
@@ -30,10 +40,40 @@ struct Successor {
 
 std::ostream &operator<<(std::ostream &os, const Successor &successor);
 
+/*
+  For each abstract state, the incoming state-changing transitions
+  (label, source state) sorted by label.
+*/
+using BackwardGraph = array_pool_template::ArrayPool<Successor>;
+
+/*
+  Keep a single copy of identical backward graphs. Since ExplicitAbstraction
+  numbers its labels canonically, abstractions whose transition systems only
+  differ in how operators map to labels share their graph. This is common for
+  projections onto overlapping patterns, where many operators only differ in
+  variables outside the pattern.
+*/
+class BackwardGraphStore {
+    std::unordered_map<
+        std::size_t, std::vector<std::shared_ptr<const BackwardGraph>>> graphs_by_hash;
+    int num_requests;
+    int num_reused_graphs;
+public:
+    BackwardGraphStore();
+
+    std::shared_ptr<const BackwardGraph> insert(BackwardGraph &&graph);
+
+    void print_statistics(utils::LogProxy &log) const;
+};
+
 
 class ExplicitAbstraction : public Abstraction {
-    // State-changing transitions.
-    std::vector<std::vector<Successor>> backward_graph;
+    // State-changing transitions, stored contiguously and grouped by target.
+    std::shared_ptr<const BackwardGraph> backward_graph;
+
+    /* Operators inducing exactly the same set of state-changing transitions
+       share a label. Labels are numbered by their sorted transition sets. */
+    array_pool_template::ArrayPool<int> label_to_operators;
 
     // Operators inducing state-changing transitions.
     std::vector<bool> active_operators;
@@ -43,14 +83,21 @@ class ExplicitAbstraction : public Abstraction {
 
     std::vector<int> goal_states;
 
+    // Reuse the queues and label costs between distance computations.
     mutable priority_queues::AdaptiveQueue<int> queue;
+    mutable std::vector<int> fifo_queue;
+    mutable std::vector<int> label_costs;
+
+    // Store the cost of each label under the given operator costs in label_costs.
+    void compute_label_costs(const std::vector<int> &costs) const;
 
 public:
     ExplicitAbstraction(
         std::unique_ptr<AbstractionFunction> abstraction_function,
         std::vector<std::vector<Successor>> &&backward_graph,
         std::vector<bool> &&looping_operators,
-        std::vector<int> &&goal_states);
+        std::vector<int> &&goal_states,
+        BackwardGraphStore &graph_store);
 
     virtual std::vector<int> compute_goal_distances(
         const std::vector<int> &costs) const override;
@@ -288,11 +288,13 @@ bool ExplicitProjectionFactory::is_goal_state(
     return true;
 }
 
-unique_ptr<Abstraction> ExplicitProjectionFactory::convert_to_abstraction() {
+unique_ptr<Abstraction> ExplicitProjectionFactory::convert_to_abstraction(
+    BackwardGraphStore &graph_store) {
     return utils::make_unique_ptr<ExplicitAbstraction>(
         utils::make_unique_ptr<ProjectionFunction>(pattern, move(hash_multipliers)),
         move(backward_graph),
         move(looping_operators),
-        move(goal_states));
+        move(goal_states),
+        graph_store);
 }
 }
@@ -64,7 +64,7 @@ public:
         const pdbs::Pattern &pattern,
         bool use_add_after_delete_semantics);
 
-    std::unique_ptr<Abstraction> convert_to_abstraction();
+    std::unique_ptr<Abstraction> convert_to_abstraction(BackwardGraphStore &graph_store);
 };
 }
 
@@ -76,6 +76,7 @@ Abstractions ProjectionGenerator::generate_abstractions(
     log << "Build projections" << endl;
     utils::Timer pdbs_timer;
     shared_ptr<TaskInfo> task_info = make_shared<TaskInfo>(task_proxy);
+    BackwardGraphStore graph_store;
     Abstractions abstractions;
     for (const pdbs::Pattern &pattern : *patterns) {
         unique_ptr<Abstraction> projection;
@@ -84,7 +85,8 @@ Abstractions ProjectionGenerator::generate_abstractions(
             projection = move((*projections)[abstractions.size()]);
         } else if (create_complete_transition_system) {
             projection = ExplicitProjectionFactory(
-                task_proxy, pattern, use_add_after_delete_semantics).convert_to_abstraction();
+                task_proxy, pattern, use_add_after_delete_semantics).convert_to_abstraction(
+                graph_store);
         } else {
             projection = utils::make_unique_ptr<Projection>(
                 task_proxy, task_info, pattern, combine_labels);
@@ -106,6 +108,9 @@ Abstractions ProjectionGenerator::generate_abstractions(
     log << "Time for building projections: " << pdbs_timer << endl;
     log << "Number of projections: " << abstractions.size() << endl;
     log << "Number of states in projections: " << collection_size << endl;
+    if (create_complete_transition_system) {
+        graph_store.print_statistics(log);
+    }
     return abstractions;
 }
 
@@ -4,6 +4,8 @@
 #include "evaluator.h"
 #include "search_statistics.h"
 
+#include "utils/profiling.h"
+
 #include <cassert>
 
 using namespace std;
@@ -45,6 +47,7 @@ EvaluationContext::EvaluationContext(
 const EvaluationResult &EvaluationContext::get_result(Evaluator *evaluator) {
     EvaluationResult &result = cache[evaluator];
     if (result.is_uninitialized()) {
+        PROFILE_COMPONENT_SCOPE(evaluator->get_profiling_component());
         result = evaluator->compute_result(*this);
         if (statistics &&
             evaluator->is_used_for_counting_evaluations() &&
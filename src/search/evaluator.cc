@@ -3,12 +3,25 @@
 #include "option_parser.h"
 #include "plugin.h"
 
+#include "utils/profiling.h"
 #include "utils/system.h"
 
 #include <cassert>
+#include <set>
 
 using namespace std;
 
+static int num_cache_slots = 0;
+static set<int> free_cache_slots;
+
+static int allocate_cache_slot() {
+    if (free_cache_slots.empty()) {
+        return num_cache_slots++;
+    }
+    int slot = *free_cache_slots.begin();
+    free_cache_slots.erase(free_cache_slots.begin());
+    return slot;
+}
 
 Evaluator::Evaluator(const options::Options &opts,
                      bool use_for_reporting_minima,
@@ -18,9 +31,27 @@ Evaluator::Evaluator(const options::Options &opts,
       use_for_reporting_minima(use_for_reporting_minima),
       use_for_boosting(use_for_boosting),
       use_for_counting_evaluations(use_for_counting_evaluations),
+      cache_slot(allocate_cache_slot()),
+      profiling_component(nullptr),
       log(utils::get_log_from_options(opts)) {
 }
 
+Evaluator::~Evaluator() {
+    free_cache_slots.insert(cache_slot);
+}
+
+int Evaluator::get_num_cache_slots() {
+    return num_cache_slots;
+}
+
+utils::ProfilingComponent &Evaluator::get_profiling_component() {
+    if (!profiling_component) {
+        profiling_component =
+            &utils::get_profiling_component("evaluator " + description);
+    }
+    return *profiling_component;
+}
+
 bool Evaluator::dead_ends_are_reliable() const {
     return true;
 }
@@ -15,11 +15,22 @@ class OptionParser;
 class Options;
 }
 
+namespace utils {
+class ProfilingComponent;
+}
+
 class Evaluator {
     const std::string description;
     const bool use_for_reporting_minima;
     const bool use_for_boosting;
     const bool use_for_counting_evaluations;
+    /*
+      Index of this evaluator's results in an EvaluatorCache. Slots are
+      unique among all existing evaluators and kept dense by reusing the
+      slots of destroyed evaluators.
+    */
+    const int cache_slot;
+    utils::ProfilingComponent *profiling_component;
 protected:
     mutable utils::LogProxy log;
 public:
@@ -28,7 +39,9 @@ public:
         bool use_for_reporting_minima = false,
         bool use_for_boosting = false,
         bool use_for_counting_evaluations = false);
-    virtual ~Evaluator() = default;
+    virtual ~Evaluator();
+    Evaluator(const Evaluator &) = delete;
+    Evaluator &operator=(const Evaluator &) = delete;
 
     /*
       dead_ends_are_reliable should return true if the evaluator is
@@ -92,6 +105,19 @@ public:
     bool is_used_for_boosting() const;
     bool is_used_for_counting_evaluations() const;
 
+    int get_cache_slot() const {
+        return cache_slot;
+    }
+    // Return an upper bound for the cache slots of all existing evaluators.
+    static int get_num_cache_slots();
+
+    /*
+      Component that measures the calls of compute_result if the planner
+      is built with USE_PROFILING. The measured times include the time
+      for computing the results of subevaluators.
+    */
+    utils::ProfilingComponent &get_profiling_component();
+
     virtual bool does_cache_estimates() const;
     virtual bool is_estimate_cached(const State &state) const;
     /*
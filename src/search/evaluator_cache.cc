@@ -1,8 +1,26 @@
 #include "evaluator_cache.h"
 
+#include "evaluator.h"
+
+#include <algorithm>
+
 using namespace std;
 
 
 EvaluationResult &EvaluatorCache::operator[](Evaluator *eval) {
-    return eval_results[eval];
+    size_t slot = eval->get_cache_slot();
+    if (slot >= entries.size()) {
+        /* Make room for all existing evaluators at once to avoid repeated
+           reallocation when evaluators are added in increasing order. */
+        entries.resize(max(slot + 1,
+                           static_cast<size_t>(Evaluator::get_num_cache_slots())));
+    }
+    Entry &entry = entries[slot];
+    if (entry.evaluator != eval) {
+        /* The slot may have belonged to an evaluator that has been
+           destroyed since. Its result must not be reported for eval. */
+        entry.evaluator = eval;
+        entry.result = EvaluationResult();
+    }
+    return entry.result;
 }
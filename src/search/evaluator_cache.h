@@ -3,27 +3,40 @@
 
 #include "evaluation_result.h"
 
-#include <unordered_map>
+#include <vector>
 
 class Evaluator;
 
-using EvaluationResults = std::unordered_map<Evaluator *, EvaluationResult>;
-
 /*
   Store evaluation results for evaluators.
+
+  Results are stored in a vector indexed by the cache slots of the
+  evaluators (see Evaluator::get_cache_slot). Since every evaluation
+  context has its own cache, this avoids allocating a hash table node for
+  each evaluator result.
 */
 class EvaluatorCache {
-    EvaluationResults eval_results;
+    struct Entry {
+        Evaluator *evaluator;
+        EvaluationResult result;
+
+        Entry()
+            : evaluator(nullptr) {
+        }
+    };
+
+    std::vector<Entry> entries;
 
 public:
     EvaluationResult &operator[](Evaluator *eval);
 
     template<class Callback>
     void for_each_evaluator_result(const Callback &callback) const {
-        for (const auto &element : eval_results) {
-            const Evaluator *eval = element.first;
-            const EvaluationResult &result = element.second;
-            callback(eval, result);
+        for (const Entry &entry : entries) {
+            if (entry.evaluator) {
+                const Evaluator *eval = entry.evaluator;
+                callback(eval, entry.result);
+            }
         }
     }
 };
@@ -17,7 +17,7 @@ using namespace std;
 
 Heuristic::Heuristic(const Options &opts)
     : Evaluator(opts, true, true, true),
-      heuristic_cache(HEntry(NO_VALUE, true)), //TODO: is true really a good idea here?
+      heuristic_cache(HEntry(NO_VALUE, true), "heuristic_cache:" + get_description()), //TODO: is true really a good idea here?
       cache_evaluator_values(opts.get<bool>("cache_estimates")),
       task(opts.get<shared_ptr<AbstractTask>>("transform")),
       task_proxy(*task) {
@@ -4,11 +4,12 @@
 #include "../plugin.h"
 
 #include "../task_utils/task_properties.h"
+#include "../utils/collections.h"
 #include "../utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
 #include <limits>
-#include <set>
 
 using namespace std;
 
@@ -17,14 +18,87 @@ HMHeuristic::HMHeuristic(const Options &opts)
     : Heuristic(opts),
       m(opts.get<int>("m")),
       has_cond_effects(task_properties::has_conditional_effects(task_proxy)),
-      goals(task_properties::get_fact_pairs(task_proxy.get_goals())) {
+      tuple_index(task_proxy.get_variables(), m) {
     if (log.is_at_least_normal()) {
         log << "Using h^" << m << "." << endl;
-        log << "The implementation of the h^m heuristic is preliminary." << endl
-            << "It is SLOOOOOOOOOOOW." << endl
-            << "Please do not use this for comparison!" << endl;
     }
-    generate_all_tuples();
+    VariablesProxy variables = task_proxy.get_variables();
+    variable_status.assign(variables.size(), FREE);
+    for (VariableProxy var : variables) {
+        domain_sizes.push_back(var.get_domain_size());
+    }
+    build_operators();
+
+    vector<int> goal_facts;
+    for (FactProxy goal : task_proxy.get_goals()) {
+        goal_facts.push_back(tuple_index.get_fact_id(goal.get_pair()));
+    }
+    sort(goal_facts.begin(), goal_facts.end());
+    tuple_index.for_each_subset_rank(
+        goal_facts, [this](int rank) {goal_ranks.push_back(rank);});
+
+    int num_ranks = tuple_index.get_num_ranks();
+    hm_table.resize(num_ranks);
+    closed.resize(num_ranks);
+    is_goal_rank.resize(num_ranks, false);
+    for (int rank : goal_ranks) {
+        is_goal_rank[rank] = true;
+    }
+    num_unsatisfied_preconditions.resize(operators.size());
+    if (m > 1) {
+        closed_partners.resize(tuple_index.get_num_facts());
+        closed_tuple_facts_by_size.resize(m + 1);
+    }
+    if (log.is_at_least_normal()) {
+        log << "Fact tuple ranks: " << num_ranks << endl;
+    }
+}
+
+
+void HMHeuristic::build_operators() {
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        HMOperator hm_op;
+        hm_op.cost = op.get_cost();
+        for (FactProxy pre : op.get_preconditions()) {
+            hm_op.preconditions.push_back(tuple_index.get_fact_id(pre.get_pair()));
+        }
+        sort(hm_op.preconditions.begin(), hm_op.preconditions.end());
+        for (EffectProxy eff : op.get_effects()) {
+            hm_op.effects.push_back(tuple_index.get_fact_id(eff.get_fact().get_pair()));
+        }
+        utils::sort_unique(hm_op.effects);
+        tuple_index.for_each_subset_rank(
+            hm_op.preconditions,
+            [&hm_op](int rank) {hm_op.precondition_ranks.push_back(rank);});
+        tuple_index.for_each_subset_rank(
+            hm_op.effects,
+            [&hm_op](int rank) {hm_op.effect_ranks.push_back(rank);});
+        if (hm_op.preconditions.empty()) {
+            ops_without_preconditions.push_back(operators.size());
+        }
+        operators.push_back(move(hm_op));
+    }
+
+    int num_ranks = tuple_index.get_num_ranks();
+    ops_by_precondition_rank_start.assign(num_ranks + 1, 0);
+    for (const HMOperator &op : operators) {
+        for (int rank : op.precondition_ranks) {
+            ++ops_by_precondition_rank_start[rank + 1];
+        }
+    }
+    for (int rank = 0; rank < num_ranks; ++rank) {
+        ops_by_precondition_rank_start[rank + 1] +=
+            ops_by_precondition_rank_start[rank];
+    }
+    ops_by_precondition_rank.resize(ops_by_precondition_rank_start.back());
+    vector<int> next_position(
+        ops_by_precondition_rank_start.begin(),
+        ops_by_precondition_rank_start.end() - 1);
+    for (size_t op_id = 0; op_id < operators.size(); ++op_id) {
+        for (int rank : operators[op_id].precondition_ranks) {
+            ops_by_precondition_rank[next_position[rank]++] = op_id;
+        }
+    }
 }
 
 
@@ -37,97 +111,139 @@ int HMHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
     if (task_properties::is_goal_state(task_proxy, state)) {
         return 0;
-    } else {
-        Tuple s_tup = task_properties::get_fact_pairs(state);
-
-        init_hm_table(s_tup);
-        update_hm_table();
+    }
 
-        int h = eval(goals);
+    fill(hm_table.begin(), hm_table.end(), numeric_limits<int>::max());
+    fill(closed.begin(), closed.end(), false);
+    for (vector<int> &partners : closed_partners) {
+        partners.clear();
+    }
+    queue.clear();
+    for (size_t op_id = 0; op_id < operators.size(); ++op_id) {
+        num_unsatisfied_preconditions[op_id] =
+            operators[op_id].precondition_ranks.size();
+    }
 
-        if (h == numeric_limits<int>::max())
-            return DEAD_END;
-        return h;
+    tuple_facts.clear();
+    for (FactProxy fact : state) {
+        tuple_facts.push_back(tuple_index.get_fact_id(fact.get_pair()));
+    }
+    tuple_index.for_each_subset_rank(
+        tuple_facts, [this](int rank) {push(rank, 0);});
+    for (int op_id : ops_without_preconditions) {
+        apply_operator(op_id, 0);
     }
-}
 
+    num_open_goals = goal_ranks.size();
+    while (!queue.empty() && num_open_goals > 0) {
+        pair<int, int> top_pair = queue.pop();
+        int cost = top_pair.first;
+        int rank = top_pair.second;
+        assert(hm_table[rank] <= cost);
+        if (closed[rank] || hm_table[rank] < cost)
+            continue;
+        close_tuple(rank, cost);
+    }
 
-void HMHeuristic::init_hm_table(const Tuple &t) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        int h_val = check_tuple_in_tuple(tuple, t);
-        hm_table[tuple] = h_val;
+    if (num_open_goals > 0)
+        return DEAD_END;
+    int h = 0;
+    for (int rank : goal_ranks) {
+        h = max(h, hm_table[rank]);
     }
+    return h;
 }
 
 
-void HMHeuristic::update_hm_table() {
-    int round = 0;
-    do {
-        ++round;
-        was_updated = false;
-
-        for (OperatorProxy op : task_proxy.get_operators()) {
-            Tuple pre = get_operator_pre(op);
+void HMHeuristic::push(int rank, int cost) {
+    if (cost < hm_table[rank]) {
+        assert(!closed[rank]);
+        hm_table[rank] = cost;
+        queue.push(cost, rank);
+    }
+}
 
-            int c1 = eval(pre);
-            if (c1 != numeric_limits<int>::max()) {
-                Tuple eff = get_operator_eff(op);
-                vector<Tuple> partial_effs;
-                generate_all_partial_tuples(eff, partial_effs);
-                for (Tuple &partial_eff : partial_effs) {
-                    update_hm_entry(partial_eff, c1 + op.get_cost());
 
-                    int eff_size = partial_eff.size();
-                    if (eff_size < m) {
-                        extend_tuple(partial_eff, op);
-                    }
+void HMHeuristic::close_tuple(int rank, int cost) {
+    /*
+      h^m values are monotone under set inclusion, so when a tuple is final
+      with the given cost, all subtuples that are still open have the same
+      cost. Closing them first guarantees that each tuple is closed after all
+      of its subtuples, which lets expand_tuple() ignore most extension rules.
+    */
+    if (m > 1 && rank >= tuple_index.get_rank_offset(2)) {
+        vector<int> &facts =
+            closed_tuple_facts_by_size[tuple_index.get_size(rank)];
+        tuple_index.get_fact_ids(rank, facts);
+        tuple_index.for_each_subset_rank(
+            facts, [this, rank, cost](int subset_rank) {
+                if (subset_rank != rank && !closed[subset_rank]) {
+                    assert(hm_table[subset_rank] >= cost);
+                    hm_table[subset_rank] = cost;
+                    close_tuple(subset_rank, cost);
                 }
-            }
+            });
+        if (facts.size() == 2) {
+            closed_partners[facts[0]].push_back(facts[1]);
+            closed_partners[facts[1]].push_back(facts[0]);
         }
-    } while (was_updated);
+    }
+    closed[rank] = true;
+    if (is_goal_rank[rank])
+        --num_open_goals;
+    expand_tuple(rank, cost);
 }
 
 
-void HMHeuristic::extend_tuple(const Tuple &t, const OperatorProxy &op) {
-    for (auto &hm_ent : hm_table) {
-        const Tuple &tuple = hm_ent.first;
-        bool contradict = false;
-        for (const FactPair &fact : tuple) {
-            if (contradict_effect_of(op, fact.var, fact.value)) {
-                contradict = true;
-                break;
-            }
+void HMHeuristic::expand_tuple(int rank, int cost) {
+    // Fire the operators whose preconditions have become final.
+    for (int i = ops_by_precondition_rank_start[rank];
+         i < ops_by_precondition_rank_start[rank + 1]; ++i) {
+        int op_id = ops_by_precondition_rank[i];
+        if (--num_unsatisfied_preconditions[op_id] == 0) {
+            apply_operator(op_id, cost);
         }
-        if (!contradict && (tuple.size() > t.size()) && (check_tuple_in_tuple(t, tuple) == 0)) {
-            Tuple pre = get_operator_pre(op);
-
-            Tuple others;
-            for (const FactPair &fact : tuple) {
-                if (find(t.begin(), t.end(), fact) == t.end()) {
-                    others.push_back(fact);
-                    if (find(pre.begin(), pre.end(), fact) == pre.end()) {
-                        pre.push_back(fact);
-                    }
-                }
-            }
-
-            sort(pre.begin(), pre.end());
+    }
 
-            set<int> vars;
-            bool is_valid = true;
-            for (const FactPair &fact : pre) {
-                if (vars.count(fact.var) != 0) {
-                    is_valid = false;
-                    break;
-                }
-                vars.insert(fact.var);
+    if (m == 1)
+        return;
+
+    /*
+      Fire the extension rules of applicable operators in which this tuple
+      consists of some facts outside the preconditions (required_facts) and
+      some precondition facts (precondition_facts). Since each tuple is
+      closed after its subtuples, the tuple can only be the last closed
+      tuple of a rule body if it has size m or if it contains the full
+      precondition and all new facts of the rule.
+    */
+    tuple_index.get_fact_ids(rank, tuple_facts);
+    int size = tuple_facts.size();
+    for (int mask = 1; mask < (1 << size); ++mask) {
+        required_facts.clear();
+        precondition_facts.clear();
+        for (int i = 0; i < size; ++i) {
+            if (mask & (1 << i)) {
+                required_facts.push_back(tuple_facts[i]);
+            } else {
+                precondition_facts.push_back(tuple_facts[i]);
             }
-
-            if (is_valid) {
-                int c2 = eval(pre);
-                if (c2 != numeric_limits<int>::max()) {
-                    update_hm_entry(tuple, c2 + op.get_cost());
+        }
+        if (static_cast<int>(required_facts.size()) >= m)
+            continue;
+        if (precondition_facts.empty()) {
+            assert(size < m);
+            for (int op_id : ops_without_preconditions) {
+                apply_extensions(op_id, cost, required_facts);
+            }
+        } else {
+            int pre_rank = tuple_index.get_rank(precondition_facts);
+            for (int i = ops_by_precondition_rank_start[pre_rank];
+                 i < ops_by_precondition_rank_start[pre_rank + 1]; ++i) {
+                int op_id = ops_by_precondition_rank[i];
+                if (num_unsatisfied_preconditions[op_id] == 0 &&
+                    (size == m || operators[op_id].preconditions.size() ==
+                     precondition_facts.size())) {
+                    apply_extensions(op_id, cost, required_facts);
                 }
             }
         }
@@ -135,131 +251,223 @@ void HMHeuristic::extend_tuple(const Tuple &t, const OperatorProxy &op) {
 }
 
 
-int HMHeuristic::eval(const Tuple &t) const {
-    vector<Tuple> partial;
-    generate_all_partial_tuples(t, partial);
-    int max = 0;
-    for (Tuple &tuple : partial) {
-        assert(hm_table.count(tuple) == 1);
-
-        int h = hm_table.at(tuple);
-        if (h > max) {
-            max = h;
-        }
+void HMHeuristic::apply_operator(int op_id, int cost) {
+    const HMOperator &op = operators[op_id];
+    int target_cost = cost + op.cost;
+    for (int rank : op.effect_ranks) {
+        push(rank, target_cost);
+    }
+    if (m > 1) {
+        apply_extensions(op_id, cost, vector<int>());
     }
-    return max;
 }
 
 
-int HMHeuristic::update_hm_entry(const Tuple &t, int val) {
-    assert(hm_table.count(t) == 1);
-    if (hm_table[t] > val) {
-        hm_table[t] = val;
-        was_updated = true;
+void HMHeuristic::apply_extensions(
+    int op_id, int cost, const vector<int> &required) {
+    const HMOperator &op = operators[op_id];
+    if (!required.empty() && !required_facts_fit_preconditions(op, required))
+        return;
+    for (int fact : op.preconditions) {
+        variable_status[tuple_index.get_variable(fact)] = fact;
+    }
+    for (int fact : op.effects) {
+        variable_status[tuple_index.get_variable(fact)] = AFFECTED;
+    }
+    bool compatible = true;
+    for (int fact : required) {
+        int &status = variable_status[tuple_index.get_variable(fact)];
+        if (status != FREE) {
+            compatible = false;
+            break;
+        }
+        status = REQUIRED;
+    }
+    if (compatible) {
+        /* For m = 2, the body tuples with new facts are the required fact
+           with and without one precondition. We have checked them above. */
+        extension = required;
+        extend(op, cost, 0, required.empty() || m != 2);
+    }
+    for (int fact : required) {
+        variable_status[tuple_index.get_variable(fact)] = FREE;
+    }
+    for (int fact : op.preconditions) {
+        variable_status[tuple_index.get_variable(fact)] = FREE;
+    }
+    for (int fact : op.effects) {
+        variable_status[tuple_index.get_variable(fact)] = FREE;
     }
-    return val;
 }
 
 
-int HMHeuristic::check_tuple_in_tuple(
-    const Tuple &tuple, const Tuple &big_tuple) const {
-    for (const FactPair &fact0 : tuple) {
-        bool found = false;
-        for (auto &fact1 : big_tuple) {
-            if (fact0 == fact1) {
-                found = true;
-                break;
-            }
+/*
+  Cheap necessary condition for firing extension rules whose new facts
+  include the required facts: each required fact lies on a variable without
+  precondition and adding any precondition to the required facts yields a
+  closed tuple (if it is small enough).
+*/
+bool HMHeuristic::required_facts_fit_preconditions(
+    const HMOperator &op, const vector<int> &required) {
+    bool check_closed = static_cast<int>(required.size()) < m;
+    for (int pre : op.preconditions) {
+        int pre_var = tuple_index.get_variable(pre);
+        head = required;
+        for (int fact : required) {
+            if (tuple_index.get_variable(fact) == pre_var)
+                return false;
         }
-        if (!found) {
-            return numeric_limits<int>::max();
+        if (check_closed) {
+            head.insert(upper_bound(head.begin(), head.end(), pre), pre);
+            if (!closed[tuple_index.get_rank(head)])
+                return false;
         }
     }
-    return 0;
-}
-
-
-HMHeuristic::Tuple HMHeuristic::get_operator_pre(const OperatorProxy &op) const {
-    Tuple preconditions = task_properties::get_fact_pairs(op.get_preconditions());
-    sort(preconditions.begin(), preconditions.end());
-    return preconditions;
+    return true;
 }
 
 
-HMHeuristic::Tuple HMHeuristic::get_operator_eff(const OperatorProxy &op) const {
-    Tuple effects;
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(eff.get_fact().get_pair());
+/*
+  Enumerate all sets O of facts that contain the required facts and
+  otherwise only facts on variables from start_var onwards that the operator
+  doesn't affect. Facts on precondition variables must match the
+  precondition. Only sets leaving room for at least one effect are used.
+  If check_body is false, the caller guarantees that all tuples in the body
+  of the rule for the current set are closed.
+*/
+void HMHeuristic::extend(
+    const HMOperator &op, int cost, int start_var, bool check_body) {
+    if (!extension.empty()) {
+        apply_extension(op, cost, check_body);
     }
-    sort(effects.begin(), effects.end());
-    return effects;
-}
-
-
-bool HMHeuristic::contradict_effect_of(
-    const OperatorProxy &op, int var, int val) const {
-    for (EffectProxy eff : op.get_effects()) {
-        FactProxy fact = eff.get_fact();
-        if (fact.get_variable().get_id() == var && fact.get_value() != val) {
-            return true;
+    if (static_cast<int>(extension.size()) >= m - 1)
+        return;
+    // Precondition facts on unaffected variables.
+    for (int fact : op.preconditions) {
+        int var = tuple_index.get_variable(fact);
+        if (var >= start_var && variable_status[var] == fact) {
+            extension.push_back(fact);
+            extend(op, cost, var + 1, true);
+            extension.pop_back();
+        }
+    }
+    /*
+      Facts on free variables. A new fact f can only occur in a rule body
+      whose subtuples are all closed if {p, f} is closed for the first
+      precondition p, so we only consider the closed partners of p.
+    */
+    if (op.preconditions.empty()) {
+        int num_variables = variable_status.size();
+        for (int var = start_var; var < num_variables; ++var) {
+            if (variable_status[var] == FREE) {
+                for (int value = 0; value < domain_sizes[var]; ++value) {
+                    extension.push_back(tuple_index.get_fact_id(var, value));
+                    extend(op, cost, var + 1, true);
+                    extension.pop_back();
+                }
+            }
+        }
+    } else {
+        for (int fact : closed_partners[op.preconditions[0]]) {
+            int var = tuple_index.get_variable(fact);
+            if (var >= start_var && variable_status[var] == FREE) {
+                extension.push_back(fact);
+                extend(op, cost, var + 1, true);
+                extension.pop_back();
+            }
         }
     }
-    return false;
-}
-
-
-void HMHeuristic::generate_all_tuples() {
-    Tuple t;
-    generate_all_tuples_aux(0, m, t);
 }
 
 
-void HMHeuristic::generate_all_tuples_aux(int var, int sz, const Tuple &base) {
-    int num_variables = task_proxy.get_variables().size();
-    for (int i = var; i < num_variables; ++i) {
-        int domain_size = task_proxy.get_variables()[i].get_domain_size();
-        for (int j = 0; j < domain_size; ++j) {
-            Tuple tuple(base);
-            tuple.emplace_back(i, j);
-            hm_table[tuple] = 0;
-            if (sz > 1) {
-                generate_all_tuples_aux(i + 1, sz - 1, tuple);
-            }
+void HMHeuristic::apply_extension(
+    const HMOperator &op, int cost, bool check_body) {
+    if (!check_body) {
+        effect_subset.clear();
+        add_effect_subsets(op, cost + op.cost, 0);
+        return;
+    }
+    // The rule body consists of the preconditions and the new facts of O.
+    body.clear();
+    body_fact_is_new.clear();
+    for (int fact : extension) {
+        if (variable_status[tuple_index.get_variable(fact)] != fact) {
+            body.push_back(fact);
         }
     }
+    int num_new = body.size();
+    body.insert(body.end(), op.preconditions.begin(), op.preconditions.end());
+    body_fact_is_new.assign(body.size(), false);
+    fill(body_fact_is_new.begin(), body_fact_is_new.begin() + num_new, true);
+    // Sort the body by fact ID while keeping track of the new facts.
+    for (size_t i = 1; i < body.size(); ++i) {
+        for (size_t j = i; j > 0 && body[j - 1] > body[j]; --j) {
+            swap(body[j - 1], body[j]);
+            bool tmp = body_fact_is_new[j - 1];
+            body_fact_is_new[j - 1] = body_fact_is_new[j];
+            body_fact_is_new[j] = tmp;
+        }
+    }
+    if (all_new_subtuples_closed(0, 0, 0, false)) {
+        effect_subset.clear();
+        add_effect_subsets(op, cost + op.cost, 0);
+    }
 }
 
 
-void HMHeuristic::generate_all_partial_tuples(
-    const Tuple &base_tuple, vector<Tuple> &res) const {
-    Tuple t;
-    generate_all_partial_tuples_aux(base_tuple, t, 0, m, res);
+bool HMHeuristic::all_new_subtuples_closed(
+    int start, int size, int partial_rank, bool includes_new) const {
+    int body_size = body.size();
+    for (int i = start; i < body_size; ++i) {
+        int rank = partial_rank + tuple_index.get_rank_summand(body[i], size + 1);
+        bool new_includes_new = includes_new || body_fact_is_new[i];
+        if (new_includes_new &&
+            !closed[tuple_index.get_rank_offset(size + 1) + rank])
+            return false;
+        if (size + 1 < m &&
+            !all_new_subtuples_closed(i + 1, size + 1, rank, new_includes_new))
+            return false;
+    }
+    return true;
 }
 
 
-void HMHeuristic::generate_all_partial_tuples_aux(
-    const Tuple &base_tuple, const Tuple &t, int index, int sz, vector<Tuple> &res) const {
-    if (sz == 1) {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-        }
-    } else {
-        for (size_t i = index; i < base_tuple.size(); ++i) {
-            Tuple tuple(t);
-            tuple.push_back(base_tuple[i]);
-            res.push_back(tuple);
-            generate_all_partial_tuples_aux(base_tuple, tuple, i + 1, sz - 1, res);
+void HMHeuristic::add_effect_subsets(
+    const HMOperator &op, int target_cost, int start) {
+    int num_effects = op.effects.size();
+    for (int i = start; i < num_effects; ++i) {
+        int fact = op.effects[i];
+        int var = tuple_index.get_variable(fact);
+        // Skip effects that contradict other (conditional) effects.
+        if ((i > 0 && tuple_index.get_variable(op.effects[i - 1]) == var) ||
+            (i + 1 < num_effects &&
+             tuple_index.get_variable(op.effects[i + 1]) == var))
+            continue;
+        effect_subset.push_back(fact);
+        head = extension;
+        head.insert(head.end(), effect_subset.begin(), effect_subset.end());
+        sort(head.begin(), head.end());
+        push(tuple_index.get_rank(head), target_cost);
+        if (static_cast<int>(head.size()) < m) {
+            add_effect_subsets(op, target_cost, i + 1);
         }
+        effect_subset.pop_back();
     }
 }
 
 
 void HMHeuristic::dump_table() const {
     if (log.is_at_least_debug()) {
-        for (auto &hm_ent : hm_table) {
-            log << "h(" << hm_ent.first << ") = " << hm_ent.second << endl;
+        vector<int> fact_ids;
+        for (int rank = 0; rank < tuple_index.get_num_ranks(); ++rank) {
+            if (hm_table[rank] == numeric_limits<int>::max())
+                continue;
+            tuple_index.get_fact_ids(rank, fact_ids);
+            Tuple tuple;
+            for (int fact_id : fact_ids) {
+                tuple.push_back(tuple_index.get_fact(fact_id));
+            }
+            log << "h(" << tuple << ") = " << hm_table[rank] << endl;
         }
     }
 }
@@ -3,10 +3,9 @@
 
 #include "../heuristic.h"
 
-#include <algorithm>
-#include <iostream>
-#include <map>
-#include <string>
+#include "../algorithms/priority_queues.h"
+#include "../task_utils/fact_tuple_index.h"
+
 #include <vector>
 
 namespace options {
@@ -17,43 +16,85 @@ namespace hm_heuristic {
 /*
   Haslum's h^m heuristic family ("critical path heuristics").
 
-  This is a very slow implementation and should not be used for
-  speed benchmarks.
+  The h^m values of all sets of at most m facts ("tuples") are stored in a
+  flat table indexed by the tuple ranks of a FactTupleIndex. We compute them
+  with a generalized Dijkstra search that finalizes the tuples in order of
+  increasing cost and fires each rule as soon as all tuples in its body are
+  final. There are two kinds of rules for an operator o. The first derives
+  each subset P of the effects of o from the preconditions of o. The second
+  derives P together with a set O of facts that o does not affect from the
+  preconditions of o and the facts in O.
 */
-
 class HMHeuristic : public Heuristic {
     using Tuple = std::vector<FactPair>;
+
+    struct HMOperator {
+        int cost;
+        // Sorted IDs of the precondition and effect facts.
+        std::vector<int> preconditions;
+        std::vector<int> effects;
+        // Ranks of all tuples contained in the preconditions and effects.
+        std::vector<int> precondition_ranks;
+        std::vector<int> effect_ranks;
+    };
+
     // parameters
     const int m;
     const bool has_cond_effects;
 
-    const Tuple goals;
-
-    // h^m table
-    std::map<Tuple, int> hm_table;
-    bool was_updated;
-
-    // auxiliary methods
-    void init_hm_table(const Tuple &t);
-    void update_hm_table();
-    int eval(const Tuple &t) const;
-    int update_hm_entry(const Tuple &t, int val);
-    void extend_tuple(const Tuple &t, const OperatorProxy &op);
-
-    int check_tuple_in_tuple(const Tuple &tuple, const Tuple &big_tuple) const;
-
-    int get_operator_pre_value(const OperatorProxy &op, int var) const;
-    Tuple get_operator_pre(const OperatorProxy &op) const;
-    Tuple get_operator_eff(const OperatorProxy &op) const;
-    bool contradict_effect_of(const OperatorProxy &op, int var, int val) const;
-
-    void generate_all_tuples();
-    void generate_all_tuples_aux(int var, int sz, const Tuple &base);
-
-    void generate_all_partial_tuples(const Tuple &base_tuple,
-                                     std::vector<Tuple> &res) const;
-    void generate_all_partial_tuples_aux(const Tuple &base_tuple, const Tuple &t, int index,
-                                         int sz, std::vector<Tuple> &res) const;
+    const fact_tuple_index::FactTupleIndex tuple_index;
+    std::vector<HMOperator> operators;
+    // Operators that have the tuple with the given rank in their preconditions.
+    std::vector<int> ops_by_precondition_rank_start;
+    std::vector<int> ops_by_precondition_rank;
+    std::vector<int> ops_without_preconditions;
+    std::vector<int> goal_ranks;
+    std::vector<bool> is_goal_rank;
+
+    // Per-evaluation data.
+    std::vector<int> hm_table;
+    std::vector<bool> closed;
+    // For m > 1: the facts f' such that {f, f'} is closed, indexed by f.
+    std::vector<std::vector<int>> closed_partners;
+    std::vector<int> num_unsatisfied_preconditions;
+    int num_open_goals;
+    priority_queues::AdaptiveQueue<int> queue;
+
+    // Scratch space for the rules that extend effects by other facts.
+    enum VariableStatus {
+        FREE = -1,
+        AFFECTED = -2,
+        REQUIRED = -3
+    };
+    // One of the above or the ID of the precondition fact on the variable.
+    std::vector<int> variable_status;
+    std::vector<int> domain_sizes;
+    std::vector<int> extension;
+    std::vector<int> body;
+    std::vector<bool> body_fact_is_new;
+    std::vector<int> effect_subset;
+    std::vector<int> head;
+    std::vector<int> tuple_facts;
+    /* close_tuple() only recurses into smaller tuples, so it can use the
+       buffer for the size of its tuple. */
+    std::vector<std::vector<int>> closed_tuple_facts_by_size;
+    std::vector<int> required_facts;
+    std::vector<int> precondition_facts;
+
+    void build_operators();
+
+    void push(int rank, int cost);
+    void apply_operator(int op_id, int cost);
+    void apply_extensions(int op_id, int cost, const std::vector<int> &required);
+    bool required_facts_fit_preconditions(
+        const HMOperator &op, const std::vector<int> &required);
+    void extend(const HMOperator &op, int cost, int start_var, bool check_body);
+    void apply_extension(const HMOperator &op, int cost, bool check_body);
+    bool all_new_subtuples_closed(
+        int start, int size, int partial_rank, bool includes_new) const;
+    void add_effect_subsets(const HMOperator &op, int target_cost, int start);
+    void close_tuple(int rank, int cost);
+    void expand_tuple(int rank, int cost);
 
     void dump_table() const;
 
@@ -4,6 +4,7 @@
 
 #include "../option_parser.h"
 #include "../plugin.h"
+#include "../state_registry.h"
 #include "../task_proxy.h"
 
 #include "../task_utils/task_properties.h"
@@ -17,7 +18,13 @@ using namespace std;
 namespace lm_cut_heuristic {
 LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
     : Heuristic(opts),
-      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)) {
+      landmark_generator(utils::make_unique_ptr<LandmarkCutLandmarks>(task_proxy)),
+      incremental(opts.get<bool>("incremental")),
+      state_landmarks(LandmarkCutLandmarks::LandmarkSet(), "lmcut_landmarks"),
+      pending_registry(nullptr),
+      pending_parent_id(StateID::no_state),
+      pending_child_id(StateID::no_state),
+      pending_op_id(-1) {
     if (log.is_at_least_normal()) {
         log << "Initializing landmark cut heuristic..." << endl;
     }
@@ -26,13 +33,79 @@ LandmarkCutHeuristic::LandmarkCutHeuristic(const Options &opts)
 LandmarkCutHeuristic::~LandmarkCutHeuristic() {
 }
 
+void LandmarkCutHeuristic::get_path_dependent_evaluators(
+    set<Evaluator *> &evals) {
+    if (incremental) {
+        evals.insert(this);
+    }
+}
+
+void LandmarkCutHeuristic::notify_state_transition(
+    const State &parent_state, OperatorID op_id, const State &state) {
+    /* Eager search generates all successors of a state before it expands
+       the next state. Once the parent changes, we therefore release the
+       landmarks of the previous parent, which is closed. If a closed state
+       is reopened, it is evaluated again and stores new landmarks. */
+    if (parent_state.get_registry() == pending_registry &&
+        parent_state.get_id() != pending_parent_id) {
+        state_landmarks[pending_registry->lookup_state(pending_parent_id)] =
+            LandmarkCutLandmarks::LandmarkSet();
+    }
+    /* Only remember the transition here: most generated successors are
+       duplicates that are never evaluated. */
+    pending_registry = parent_state.get_registry();
+    pending_parent_id = parent_state.get_id();
+    pending_child_id = state.get_id();
+    pending_op_id = op_id.get_index();
+}
+
+int LandmarkCutHeuristic::compute_reused_landmarks(const State &ancestor_state) {
+    reused_landmarks.clear();
+    if (!ancestor_state.get_registry() ||
+        ancestor_state.get_registry() != pending_registry ||
+        ancestor_state.get_id() != pending_child_id) {
+        return 0;
+    }
+    /* If the parent has not been evaluated (e.g., because its value came
+       from another evaluator), we find no landmarks and compute all cuts. */
+    const PerStateInformation<LandmarkCutLandmarks::LandmarkSet> &landmarks =
+        state_landmarks;
+    return reused_landmarks.add_landmarks_without_operator(
+        landmarks[pending_registry->lookup_state(pending_parent_id)],
+        pending_op_id);
+}
+
 int LandmarkCutHeuristic::compute_heuristic(const State &ancestor_state) {
     State state = convert_ancestor_state(ancestor_state);
-    int total_cost = 0;
+    if (!incremental) {
+        int total_cost = 0;
+        bool dead_end = landmark_generator->compute_landmarks(
+            state,
+            [&total_cost](int cut_cost) {total_cost += cut_cost;},
+            nullptr);
+        if (dead_end)
+            return DEAD_END;
+        return total_cost;
+    }
+
+    int total_cost = compute_reused_landmarks(ancestor_state);
+    new_landmarks.clear();
     bool dead_end = landmark_generator->compute_landmarks(
-        state,
-        [&total_cost](int cut_cost) {total_cost += cut_cost;},
-        nullptr);
+        state, reused_landmarks, nullptr,
+        [this, &total_cost](const LandmarkCutLandmarks::Landmark &landmark, int cost) {
+            new_landmarks.add_landmark(landmark, cost);
+            total_cost += cost;
+        });
+    if (ancestor_state.get_registry()) {
+        /* Copy instead of swapping, so that the stored set uses no more
+           memory than needed and reused_landmarks keeps its capacity. */
+        LandmarkCutLandmarks::LandmarkSet &landmarks = state_landmarks[ancestor_state];
+        landmarks.clear();
+        if (!dead_end) {
+            reused_landmarks.add_landmarks(new_landmarks);
+            landmarks = reused_landmarks;
+        }
+    }
 
     if (dead_end)
         return DEAD_END;
@@ -49,6 +122,20 @@ static shared_ptr<Heuristic> _parse(OptionParser &parser) {
     parser.document_property("safe", "yes");
     parser.document_property("preferred operators", "no");
 
+    parser.add_option<bool>(
+        "incremental",
+        "reuse the landmarks of the parent state that do not contain the "
+        "operator leading to the evaluated state and only compute new cuts "
+        "for the remaining operator costs. The resulting estimates are "
+        "admissible, but path-dependent and may differ from plain LM-cut. "
+        "Assumes that the heuristic task has the same operators as the "
+        "search task. The landmarks are stored for each evaluated state "
+        "until the search generates the successors of another state, "
+        "which bounds the extra memory by the landmarks of the states in "
+        "the open list plus one empty set per registered state. Lazy "
+        "search interleaves the successors of different states, so it "
+        "reuses fewer landmarks than eager search.",
+        "false");
     Heuristic::add_options_to_parser(parser);
     Options opts = parser.parse();
     if (parser.dry_run())
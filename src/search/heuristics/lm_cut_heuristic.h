@@ -1,7 +1,10 @@
 #ifndef HEURISTICS_LM_CUT_HEURISTIC_H
 #define HEURISTICS_LM_CUT_HEURISTIC_H
 
+#include "lm_cut_landmarks.h"
+
 #include "../heuristic.h"
+#include "../per_state_information.h"
 
 #include <memory>
 
@@ -10,15 +13,40 @@ class Options;
 }
 
 namespace lm_cut_heuristic {
-class LandmarkCutLandmarks;
-
 class LandmarkCutHeuristic : public Heuristic {
     std::unique_ptr<LandmarkCutLandmarks> landmark_generator;
 
+    /*
+      In incremental mode, the landmarks of a parent state that do not
+      contain the operator leading to a successor are still landmarks of the
+      successor, and their costs still form a valid cost partitioning. We
+      reuse them in the successor and only compute cuts for the remaining
+      costs. To this end, we store the landmarks of each evaluated state
+      that belongs to a state registry until its successors have been
+      generated.
+    */
+    const bool incremental;
+    PerStateInformation<LandmarkCutLandmarks::LandmarkSet> state_landmarks;
+    // Landmarks of the current state: reused ones first, then new ones.
+    LandmarkCutLandmarks::LandmarkSet reused_landmarks;
+    LandmarkCutLandmarks::LandmarkSet new_landmarks;
+    // Last transition reported by notify_state_transition.
+    const StateRegistry *pending_registry;
+    StateID pending_parent_id;
+    StateID pending_child_id;
+    int pending_op_id;
+
+    int compute_reused_landmarks(const State &ancestor_state);
     virtual int compute_heuristic(const State &ancestor_state) override;
 public:
     explicit LandmarkCutHeuristic(const options::Options &opts);
     virtual ~LandmarkCutHeuristic() override;
+
+    virtual void get_path_dependent_evaluators(
+        std::set<Evaluator *> &evals) override;
+    virtual void notify_state_transition(
+        const State &parent_state, OperatorID op_id,
+        const State &state) override;
 };
 }
 
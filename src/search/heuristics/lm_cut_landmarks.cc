@@ -15,18 +15,28 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
     task_properties::verify_no_conditional_effects(task_proxy);
 
     // Build propositions.
-    num_propositions = 2; // artificial goal and artificial precondition
-    VariablesProxy variables = task_proxy.get_variables();
-    propositions.resize(variables.size());
-    for (FactProxy fact : variables.get_facts()) {
-        int var_id = fact.get_variable().get_id();
-        propositions[var_id].push_back(RelaxedProposition());
-        ++num_propositions;
+    int num_facts = 0;
+    for (VariableProxy var : task_proxy.get_variables()) {
+        proposition_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
     }
+    artificial_precondition = num_facts;
+    artificial_goal = num_facts + 1;
+    propositions.resize(num_facts + 2);
 
     // Build relaxed operators for operators and axioms.
-    for (OperatorProxy op : task_proxy.get_operators())
-        build_relaxed_operator(op);
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorProxy op : operators) {
+        vector<PropID> op_pre;
+        for (FactProxy pre : op.get_preconditions()) {
+            op_pre.push_back(get_prop_id(pre));
+        }
+        vector<PropID> op_eff;
+        for (EffectProxy eff : op.get_effects()) {
+            op_eff.push_back(get_prop_id(eff.get_fact()));
+        }
+        add_relaxed_operator(move(op_pre), move(op_eff), op.get_cost());
+    }
 
     // Simplify relaxed operators.
     // simplify();
@@ -34,84 +44,71 @@ LandmarkCutLandmarks::LandmarkCutLandmarks(const TaskProxy &task_proxy) {
        but only after trying out whether and how much the change to
        unary operators hurts. */
 
-    // Build artificial goal proposition and operator.
-    vector<RelaxedProposition *> goal_op_pre, goal_op_eff;
+    /* Build artificial goal operator. Its ID is the number of operators, so
+       it can never be confused with an operator of the task. */
+    vector<PropID> goal_op_pre;
     for (FactProxy goal : task_proxy.get_goals()) {
-        goal_op_pre.push_back(get_proposition(goal));
+        goal_op_pre.push_back(get_prop_id(goal));
     }
-    goal_op_eff.push_back(&artificial_goal);
-    /* Use the invalid operator ID -1 so accessing
-       the artificial operator will generate an error. */
-    add_relaxed_operator(move(goal_op_pre), move(goal_op_eff), -1, 0);
+    add_relaxed_operator(move(goal_op_pre), {artificial_goal}, 0);
+    relaxed_operators.resize(base_costs.size());
 
     // Cross-reference relaxed operators.
-    for (RelaxedOperator &op : relaxed_operators) {
-        for (RelaxedProposition *pre : op.preconditions)
-            pre->precondition_of.push_back(&op);
-        for (RelaxedProposition *eff : op.effects)
-            eff->effect_of.push_back(&op);
+    int num_props = propositions.size();
+    int num_ops = relaxed_operators.size();
+    vector<vector<OpID>> prop_precondition_of(num_props);
+    vector<vector<OpID>> prop_effect_of(num_props);
+    for (OpID op_id = 0; op_id < num_ops; ++op_id) {
+        for (PropID pre : preconditions[op_id])
+            prop_precondition_of[pre].push_back(op_id);
+        for (PropID eff : effects[op_id])
+            prop_effect_of[eff].push_back(op_id);
+    }
+    for (PropID prop_id = 0; prop_id < num_props; ++prop_id) {
+        precondition_of.push_back(move(prop_precondition_of[prop_id]));
+        effect_of.push_back(move(prop_effect_of[prop_id]));
     }
 }
 
 LandmarkCutLandmarks::~LandmarkCutLandmarks() {
 }
 
-void LandmarkCutLandmarks::build_relaxed_operator(const OperatorProxy &op) {
-    vector<RelaxedProposition *> precondition;
-    vector<RelaxedProposition *> effects;
-    for (FactProxy pre : op.get_preconditions()) {
-        precondition.push_back(get_proposition(pre));
-    }
-    for (EffectProxy eff : op.get_effects()) {
-        effects.push_back(get_proposition(eff.get_fact()));
-    }
-    add_relaxed_operator(
-        move(precondition), move(effects), op.get_id(), op.get_cost());
-}
-
 void LandmarkCutLandmarks::add_relaxed_operator(
-    vector<RelaxedProposition *> &&precondition,
-    vector<RelaxedProposition *> &&effects,
-    int op_id, int base_cost) {
-    RelaxedOperator relaxed_op(
-        move(precondition), move(effects), op_id, base_cost);
-    if (relaxed_op.preconditions.empty())
-        relaxed_op.preconditions.push_back(&artificial_precondition);
-    relaxed_operators.push_back(relaxed_op);
+    vector<PropID> &&precondition, vector<PropID> &&effect, int base_cost) {
+    if (precondition.empty())
+        precondition.push_back(artificial_precondition);
+    preconditions.push_back(move(precondition));
+    effects.push_back(move(effect));
+    base_costs.push_back(base_cost);
 }
 
-RelaxedProposition *LandmarkCutLandmarks::get_proposition(
-    const FactProxy &fact) {
+PropID LandmarkCutLandmarks::get_prop_id(const FactProxy &fact) const {
     int var_id = fact.get_variable().get_id();
-    int val = fact.get_value();
-    return &propositions[var_id][val];
+    return proposition_offsets[var_id] + fact.get_value();
 }
 
 // heuristic computation
 void LandmarkCutLandmarks::setup_exploration_queue() {
     priority_queue.clear();
 
-    for (auto &var_props : propositions) {
-        for (RelaxedProposition &prop : var_props) {
-            prop.status = UNREACHED;
-        }
+    for (RelaxedProposition &prop : propositions) {
+        prop.status = UNREACHED;
     }
 
-    artificial_goal.status = UNREACHED;
-    artificial_precondition.status = UNREACHED;
-
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.unsatisfied_preconditions = op.preconditions.size();
-        op.h_max_supporter = 0;
+    for (size_t op_id = 0; op_id < relaxed_operators.size(); ++op_id) {
+        RelaxedOperator &op = relaxed_operators[op_id];
+        Slice pre = preconditions[op_id];
+        op.unsatisfied_preconditions = pre.end() - pre.begin();
+        op.h_max_supporter = NO_PROP;
         op.h_max_supporter_cost = numeric_limits<int>::max();
     }
 }
 
 void LandmarkCutLandmarks::setup_exploration_queue_state(const State &state) {
     for (FactProxy init_fact : state) {
-        enqueue_if_necessary(get_proposition(init_fact), 0);
+        enqueue_if_necessary(get_prop_id(init_fact), 0);
     }
-    enqueue_if_necessary(&artificial_precondition, 0);
+    enqueue_if_necessary(artificial_precondition, 0);
 }
 
 void LandmarkCutLandmarks::first_exploration(const State &state) {
@@ -119,23 +116,22 @@ void LandmarkCutLandmarks::first_exploration(const State &state) {
     setup_exploration_queue();
     setup_exploration_queue_state(state);
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, PropID> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        PropID prop_id = top_pair.second;
+        int prop_cost = propositions[prop_id].h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            --relaxed_op->unsatisfied_preconditions;
-            assert(relaxed_op->unsatisfied_preconditions >= 0);
-            if (relaxed_op->unsatisfied_preconditions == 0) {
-                relaxed_op->h_max_supporter = prop;
-                relaxed_op->h_max_supporter_cost = prop_cost;
-                int target_cost = prop_cost + relaxed_op->cost;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
+        for (OpID op_id : precondition_of[prop_id]) {
+            RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            --relaxed_op.unsatisfied_preconditions;
+            assert(relaxed_op.unsatisfied_preconditions >= 0);
+            if (relaxed_op.unsatisfied_preconditions == 0) {
+                relaxed_op.h_max_supporter = prop_id;
+                relaxed_op.h_max_supporter_cost = prop_cost;
+                int target_cost = prop_cost + relaxed_op.cost;
+                for (PropID effect : effects[op_id]) {
                     enqueue_if_necessary(effect, target_cost);
                 }
             }
@@ -143,41 +139,54 @@ void LandmarkCutLandmarks::first_exploration(const State &state) {
     }
 }
 
-void LandmarkCutLandmarks::first_exploration_incremental(
-    vector<RelaxedOperator *> &cut) {
+void LandmarkCutLandmarks::update_h_max_supporter(OpID op_id) {
+    RelaxedOperator &op = relaxed_operators[op_id];
+    assert(!op.unsatisfied_preconditions);
+    int supporter_cost = propositions[op.h_max_supporter].h_max_cost;
+    for (PropID pre : preconditions[op_id]) {
+        int pre_cost = propositions[pre].h_max_cost;
+        if (pre_cost > supporter_cost) {
+            op.h_max_supporter = pre;
+            supporter_cost = pre_cost;
+        }
+    }
+    op.h_max_supporter_cost = supporter_cost;
+}
+
+void LandmarkCutLandmarks::first_exploration_incremental(vector<OpID> &cut) {
     assert(priority_queue.empty());
     /* We pretend that this queue has had as many pushes already as we
        have propositions to avoid switching from bucket-based to
        heap-based too aggressively. This should prevent ever switching
        to heap-based in problems where action costs are at most 1.
     */
-    priority_queue.add_virtual_pushes(num_propositions);
-    for (RelaxedOperator *relaxed_op : cut) {
-        int cost = relaxed_op->h_max_supporter_cost + relaxed_op->cost;
-        for (RelaxedProposition *effect : relaxed_op->effects)
+    priority_queue.add_virtual_pushes(propositions.size());
+    for (OpID op_id : cut) {
+        const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+        int cost = relaxed_op.h_max_supporter_cost + relaxed_op.cost;
+        for (PropID effect : effects[op_id])
             enqueue_if_necessary(effect, cost);
     }
     while (!priority_queue.empty()) {
-        pair<int, RelaxedProposition *> top_pair = priority_queue.pop();
+        pair<int, PropID> top_pair = priority_queue.pop();
         int popped_cost = top_pair.first;
-        RelaxedProposition *prop = top_pair.second;
-        int prop_cost = prop->h_max_cost;
+        PropID prop_id = top_pair.second;
+        int prop_cost = propositions[prop_id].h_max_cost;
         assert(prop_cost <= popped_cost);
         if (prop_cost < popped_cost)
             continue;
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
-                int old_supp_cost = relaxed_op->h_max_supporter_cost;
+        for (OpID op_id : precondition_of[prop_id]) {
+            RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (relaxed_op.h_max_supporter == prop_id) {
+                int old_supp_cost = relaxed_op.h_max_supporter_cost;
                 if (old_supp_cost > prop_cost) {
-                    relaxed_op->update_h_max_supporter();
-                    int new_supp_cost = relaxed_op->h_max_supporter_cost;
+                    update_h_max_supporter(op_id);
+                    int new_supp_cost = relaxed_op.h_max_supporter_cost;
                     if (new_supp_cost != old_supp_cost) {
                         // This operator has become cheaper.
                         assert(new_supp_cost < old_supp_cost);
-                        int target_cost = new_supp_cost + relaxed_op->cost;
-                        for (RelaxedProposition *effect : relaxed_op->effects)
+                        int target_cost = new_supp_cost + relaxed_op.cost;
+                        for (PropID effect : effects[op_id])
                             enqueue_if_necessary(effect, target_cost);
                     }
                 }
@@ -187,41 +196,42 @@ void LandmarkCutLandmarks::first_exploration_incremental(
 }
 
 void LandmarkCutLandmarks::second_exploration(
-    const State &state, vector<RelaxedProposition *> &second_exploration_queue,
-    vector<RelaxedOperator *> &cut) {
+    const State &state, vector<PropID> &second_exploration_queue,
+    vector<OpID> &cut) {
     assert(second_exploration_queue.empty());
     assert(cut.empty());
 
-    artificial_precondition.status = BEFORE_GOAL_ZONE;
-    second_exploration_queue.push_back(&artificial_precondition);
+    propositions[artificial_precondition].status = BEFORE_GOAL_ZONE;
+    second_exploration_queue.push_back(artificial_precondition);
 
     for (FactProxy init_fact : state) {
-        RelaxedProposition *init_prop = get_proposition(init_fact);
-        init_prop->status = BEFORE_GOAL_ZONE;
+        PropID init_prop = get_prop_id(init_fact);
+        propositions[init_prop].status = BEFORE_GOAL_ZONE;
         second_exploration_queue.push_back(init_prop);
     }
 
     while (!second_exploration_queue.empty()) {
-        RelaxedProposition *prop = second_exploration_queue.back();
+        PropID prop_id = second_exploration_queue.back();
         second_exploration_queue.pop_back();
-        const vector<RelaxedOperator *> &triggered_operators =
-            prop->precondition_of;
-        for (RelaxedOperator *relaxed_op : triggered_operators) {
-            if (relaxed_op->h_max_supporter == prop) {
+        for (OpID op_id : precondition_of[prop_id]) {
+            const RelaxedOperator &relaxed_op = relaxed_operators[op_id];
+            if (relaxed_op.h_max_supporter == prop_id) {
                 bool reached_goal_zone = false;
-                for (RelaxedProposition *effect : relaxed_op->effects) {
-                    if (effect->status == GOAL_ZONE) {
-                        assert(relaxed_op->cost > 0);
+                Slice op_effects = effects[op_id];
+                for (PropID effect : op_effects) {
+                    if (propositions[effect].status == GOAL_ZONE) {
+                        assert(relaxed_op.cost > 0);
                         reached_goal_zone = true;
-                        cut.push_back(relaxed_op);
+                        cut.push_back(op_id);
                         break;
                     }
                 }
                 if (!reached_goal_zone) {
-                    for (RelaxedProposition *effect : relaxed_op->effects) {
-                        if (effect->status != BEFORE_GOAL_ZONE) {
-                            assert(effect->status == REACHED);
-                            effect->status = BEFORE_GOAL_ZONE;
+                    for (PropID effect : op_effects) {
+                        RelaxedProposition &prop = propositions[effect];
+                        if (prop.status != BEFORE_GOAL_ZONE) {
+                            assert(prop.status == REACHED);
+                            prop.status = BEFORE_GOAL_ZONE;
                             second_exploration_queue.push_back(effect);
                         }
                     }
@@ -231,16 +241,16 @@ void LandmarkCutLandmarks::second_exploration(
     }
 }
 
-void LandmarkCutLandmarks::mark_goal_plateau(RelaxedProposition *subgoal) {
-    // NOTE: subgoal can be null if we got here via recursion through
+void LandmarkCutLandmarks::mark_goal_plateau(PropID subgoal) {
+    // NOTE: subgoal can be NO_PROP if we got here via recursion through
     // a zero-cost action that is relaxed unreachable. (This can only
     // happen in domains which have zero-cost actions to start with.)
     // For example, this happens in pegsol-strips #01.
-    if (subgoal && subgoal->status != GOAL_ZONE) {
-        subgoal->status = GOAL_ZONE;
-        for (RelaxedOperator *achiever : subgoal->effect_of)
-            if (achiever->cost == 0)
-                mark_goal_plateau(achiever->h_max_supporter);
+    if (subgoal != NO_PROP && propositions[subgoal].status != GOAL_ZONE) {
+        propositions[subgoal].status = GOAL_ZONE;
+        for (OpID achiever : effect_of[subgoal])
+            if (relaxed_operators[achiever].cost == 0)
+                mark_goal_plateau(relaxed_operators[achiever].h_max_supporter);
     }
 }
 
@@ -249,69 +259,113 @@ void LandmarkCutLandmarks::validate_h_max() const {
     // Using conditional compilation to avoid complaints about unused
     // variables when using NDEBUG. This whole code does nothing useful
     // when assertions are switched off anyway.
-    for (const RelaxedOperator &op : relaxed_operators) {
+    for (size_t op_id = 0; op_id < relaxed_operators.size(); ++op_id) {
+        const RelaxedOperator &op = relaxed_operators[op_id];
         if (op.unsatisfied_preconditions) {
             bool reachable = true;
-            for (RelaxedProposition *pre : op.preconditions) {
-                if (pre->status == UNREACHED) {
+            for (PropID pre : preconditions[op_id]) {
+                if (propositions[pre].status == UNREACHED) {
                     reachable = false;
                     break;
                 }
             }
             assert(!reachable);
-            assert(!op.h_max_supporter);
+            assert(op.h_max_supporter == NO_PROP);
         } else {
-            assert(op.h_max_supporter);
+            assert(op.h_max_supporter != NO_PROP);
             int h_max_cost = op.h_max_supporter_cost;
-            assert(h_max_cost == op.h_max_supporter->h_max_cost);
-            for (RelaxedProposition *pre : op.preconditions) {
-                assert(pre->status != UNREACHED);
-                assert(pre->h_max_cost <= h_max_cost);
+            assert(h_max_cost == propositions[op.h_max_supporter].h_max_cost);
+            for (PropID pre : preconditions[op_id]) {
+                assert(propositions[pre].status != UNREACHED);
+                assert(propositions[pre].h_max_cost <= h_max_cost);
             }
         }
     }
 #endif
 }
 
+void LandmarkCutLandmarks::LandmarkSet::add_landmark(
+    const Landmark &landmark, int cost) {
+    data.push_back(cost);
+    data.push_back(landmark.size());
+    data.insert(data.end(), landmark.begin(), landmark.end());
+}
+
+void LandmarkCutLandmarks::LandmarkSet::add_landmarks(const LandmarkSet &other) {
+    data.insert(data.end(), other.data.begin(), other.data.end());
+}
+
+int LandmarkCutLandmarks::LandmarkSet::add_landmarks_without_operator(
+    const LandmarkSet &other, int op_id) {
+    int total_cost = 0;
+    other.for_each_landmark(
+        [this, op_id, &total_cost](
+            int cost, vector<int>::const_iterator begin,
+            vector<int>::const_iterator end) {
+            if (find(begin, end, op_id) == end) {
+                data.push_back(cost);
+                data.push_back(end - begin);
+                data.insert(data.end(), begin, end);
+                total_cost += cost;
+            }
+        });
+    return total_cost;
+}
+
 bool LandmarkCutLandmarks::compute_landmarks(
     const State &state, CostCallback cost_callback,
     LandmarkCallback landmark_callback) {
-    for (RelaxedOperator &op : relaxed_operators) {
-        op.cost = op.base_cost;
+    return compute_landmarks(
+        state, LandmarkSet(), cost_callback, landmark_callback);
+}
+
+bool LandmarkCutLandmarks::compute_landmarks(
+    const State &state, const LandmarkSet &reused_landmarks,
+    CostCallback cost_callback, LandmarkCallback landmark_callback) {
+    int num_ops = relaxed_operators.size();
+    for (OpID op_id = 0; op_id < num_ops; ++op_id) {
+        relaxed_operators[op_id].cost = base_costs[op_id];
     }
+    reused_landmarks.for_each_landmark(
+        [this](int cost, vector<int>::const_iterator begin,
+               vector<int>::const_iterator end) {
+            for (auto it = begin; it != end; ++it) {
+                RelaxedOperator &op = relaxed_operators[*it];
+                op.cost -= cost;
+                assert(op.cost >= 0);
+            }
+        });
     // The following three variables could be declared inside the loop
     // ("second_exploration_queue" even inside second_exploration),
     // but having them here saves reallocations and hence provides a
     // measurable speed boost.
-    vector<RelaxedOperator *> cut;
+    vector<OpID> cut;
     Landmark landmark;
-    vector<RelaxedProposition *> second_exploration_queue;
+    vector<PropID> second_exploration_queue;
     first_exploration(state);
     // validate_h_max();  // too expensive to use even in regular debug mode
-    if (artificial_goal.status == UNREACHED)
+    if (propositions[artificial_goal].status == UNREACHED)
         return true;
 
     int num_iterations = 0;
-    while (artificial_goal.h_max_cost != 0) {
+    while (propositions[artificial_goal].h_max_cost != 0) {
         ++num_iterations;
-        mark_goal_plateau(&artificial_goal);
+        mark_goal_plateau(artificial_goal);
         assert(cut.empty());
         second_exploration(state, second_exploration_queue, cut);
         assert(!cut.empty());
         int cut_cost = numeric_limits<int>::max();
-        for (RelaxedOperator *op : cut)
-            cut_cost = min(cut_cost, op->cost);
-        for (RelaxedOperator *op : cut)
-            op->cost -= cut_cost;
+        for (OpID op_id : cut)
+            cut_cost = min(cut_cost, relaxed_operators[op_id].cost);
+        for (OpID op_id : cut)
+            relaxed_operators[op_id].cost -= cut_cost;
 
         if (cost_callback) {
             cost_callback(cut_cost);
         }
         if (landmark_callback) {
             landmark.clear();
-            for (RelaxedOperator *op : cut) {
-                landmark.push_back(op->original_op_id);
-            }
+            landmark.insert(landmark.end(), cut.begin(), cut.end());
             landmark_callback(landmark, cut_cost);
         }
 
@@ -325,14 +379,10 @@ bool LandmarkCutLandmarks::compute_landmarks(
           or something based on total_cost, so that we don't need a per-round
           reinitialization.
         */
-        for (auto &var_props : propositions) {
-            for (RelaxedProposition &prop : var_props) {
-                if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
-                    prop.status = REACHED;
-            }
+        for (RelaxedProposition &prop : propositions) {
+            if (prop.status == GOAL_ZONE || prop.status == BEFORE_GOAL_ZONE)
+                prop.status = REACHED;
         }
-        artificial_goal.status = REACHED;
-        artificial_precondition.status = REACHED;
     }
     return false;
 }
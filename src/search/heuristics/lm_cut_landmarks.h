@@ -3,6 +3,7 @@
 
 #include "../task_proxy.h"
 
+#include "../algorithms/array_pool.h"
 #include "../algorithms/priority_queues.h"
 
 #include <cassert>
@@ -12,7 +13,10 @@
 
 namespace lm_cut_heuristic {
 // TODO: Fix duplication with the other relaxation heuristics.
-struct RelaxedProposition;
+using PropID = int;
+using OpID = int;
+
+const PropID NO_PROP = -1;
 
 enum PropositionStatus {
     UNREACHED = 0,
@@ -21,70 +25,109 @@ enum PropositionStatus {
     BEFORE_GOAL_ZONE = 3
 };
 
+/*
+  The relaxed task is stored in flat arrays indexed by PropID and OpID. The
+  structs below only hold the fields that change during the explorations;
+  the static structure (preconditions, effects and their inverses) lives in
+  array pools and the base costs in a separate vector.
+*/
 struct RelaxedOperator {
-    int original_op_id;
-    std::vector<RelaxedProposition *> preconditions;
-    std::vector<RelaxedProposition *> effects;
-    int base_cost; // 0 for axioms, 1 for regular operators
-
     int cost;
     int unsatisfied_preconditions;
     int h_max_supporter_cost; // h_max_cost of h_max_supporter
-    RelaxedProposition *h_max_supporter;
-    RelaxedOperator(std::vector<RelaxedProposition *> &&pre,
-                    std::vector<RelaxedProposition *> &&eff,
-                    int op_id, int base)
-        : original_op_id(op_id), preconditions(pre), effects(eff), base_cost(base) {
-    }
-
-    inline void update_h_max_supporter();
+    PropID h_max_supporter;
 };
 
-struct RelaxedProposition {
-    std::vector<RelaxedOperator *> precondition_of;
-    std::vector<RelaxedOperator *> effect_of;
+static_assert(sizeof(RelaxedOperator) == 16, "RelaxedOperator has wrong size");
 
+struct RelaxedProposition {
     PropositionStatus status;
     int h_max_cost;
 };
 
+static_assert(sizeof(RelaxedProposition) == 8, "RelaxedProposition has wrong size");
+
 class LandmarkCutLandmarks {
+    using Pool = array_pool_template::ArrayPool<int>;
+    using Slice = array_pool_template::ArrayPoolSlice<int>;
+
+    /*
+      Operators are indexed like the operators of the task, followed by the
+      artificial goal operator. Propositions are indexed by fact, followed by
+      the artificial precondition and the artificial goal.
+    */
     std::vector<RelaxedOperator> relaxed_operators;
-    std::vector<std::vector<RelaxedProposition>> propositions;
-    RelaxedProposition artificial_precondition;
-    RelaxedProposition artificial_goal;
-    int num_propositions;
-    priority_queues::AdaptiveQueue<RelaxedProposition *> priority_queue;
-
-    void build_relaxed_operator(const OperatorProxy &op);
-    void add_relaxed_operator(std::vector<RelaxedProposition *> &&precondition,
-                              std::vector<RelaxedProposition *> &&effects,
-                              int op_id, int base_cost);
-    RelaxedProposition *get_proposition(const FactProxy &fact);
+    std::vector<RelaxedProposition> propositions;
+    std::vector<int> base_costs;
+    Pool preconditions;
+    Pool effects;
+    Pool precondition_of;
+    Pool effect_of;
+    std::vector<PropID> proposition_offsets;
+    PropID artificial_precondition;
+    PropID artificial_goal;
+    priority_queues::AdaptiveQueue<PropID> priority_queue;
+
+    void add_relaxed_operator(std::vector<PropID> &&precondition,
+                              std::vector<PropID> &&effect, int base_cost);
+    PropID get_prop_id(const FactProxy &fact) const;
     void setup_exploration_queue();
     void setup_exploration_queue_state(const State &state);
     void first_exploration(const State &state);
-    void first_exploration_incremental(std::vector<RelaxedOperator *> &cut);
+    void first_exploration_incremental(std::vector<OpID> &cut);
     void second_exploration(const State &state,
-                            std::vector<RelaxedProposition *> &second_exploration_queue,
-                            std::vector<RelaxedOperator *> &cut);
+                            std::vector<PropID> &second_exploration_queue,
+                            std::vector<OpID> &cut);
 
-    void enqueue_if_necessary(RelaxedProposition *prop, int cost) {
+    void enqueue_if_necessary(PropID prop_id, int cost) {
         assert(cost >= 0);
-        if (prop->status == UNREACHED || prop->h_max_cost > cost) {
-            prop->status = REACHED;
-            prop->h_max_cost = cost;
-            priority_queue.push(cost, prop);
+        RelaxedProposition &prop = propositions[prop_id];
+        if (prop.status == UNREACHED || prop.h_max_cost > cost) {
+            prop.status = REACHED;
+            prop.h_max_cost = cost;
+            priority_queue.push(cost, prop_id);
         }
     }
 
-    void mark_goal_plateau(RelaxedProposition *subgoal);
+    void update_h_max_supporter(OpID op_id);
+    void mark_goal_plateau(PropID subgoal);
     void validate_h_max() const;
 public:
     using Landmark = std::vector<int>;
     using CostCallback = std::function<void (int)>;
     using LandmarkCallback = std::function<void (const Landmark &, int)>;
 
+    /*
+      Compact representation of a set of landmarks with their costs. For
+      each landmark, we store its cost, its number of operators and its
+      operators consecutively in a single vector.
+    */
+    class LandmarkSet {
+        std::vector<int> data;
+    public:
+        void add_landmark(const Landmark &landmark, int cost);
+        void add_landmarks(const LandmarkSet &other);
+        /* Add all landmarks of other that do not contain the given operator.
+           Return the total cost of the added landmarks. */
+        int add_landmarks_without_operator(const LandmarkSet &other, int op_id);
+
+        void clear() {
+            data.clear();
+        }
+
+        // Call callback(cost, operators_begin, operators_end) for each landmark.
+        template<typename Callback>
+        void for_each_landmark(const Callback &callback) const {
+            auto it = data.begin();
+            while (it != data.end()) {
+                int cost = *it++;
+                int num_operators = *it++;
+                callback(cost, it, it + num_operators);
+                it += num_operators;
+            }
+        }
+    };
+
     LandmarkCutLandmarks(const TaskProxy &task_proxy);
     virtual ~LandmarkCutLandmarks();
 
@@ -103,15 +146,18 @@ public:
     */
     bool compute_landmarks(const State &state, CostCallback cost_callback,
                            LandmarkCallback landmark_callback);
-};
 
-inline void RelaxedOperator::update_h_max_supporter() {
-    assert(!unsatisfied_preconditions);
-    for (size_t i = 0; i < preconditions.size(); ++i)
-        if (preconditions[i]->h_max_cost > h_max_supporter->h_max_cost)
-            h_max_supporter = preconditions[i];
-    h_max_supporter_cost = h_max_supporter->h_max_cost;
-}
+    /*
+      Like compute_landmarks, but start from the cost function that remains
+      after subtracting the costs of the given landmarks from the operator
+      costs. The caller must ensure that these landmarks are landmarks of the
+      given state and that their costs form a valid cost partitioning. Only
+      the newly discovered landmarks are passed to the callbacks.
+    */
+    bool compute_landmarks(const State &state, const LandmarkSet &reused_landmarks,
+                           CostCallback cost_callback,
+                           LandmarkCallback landmark_callback);
+};
 }
 
 #endif
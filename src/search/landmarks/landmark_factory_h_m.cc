@@ -10,8 +10,11 @@
 #include "../task_utils/task_properties.h"
 #include "../utils/collections.h"
 #include "../utils/logging.h"
+#include "../utils/memory.h"
 #include "../utils/system.h"
 
+#include <algorithm>
+
 using namespace std;
 using utils::ExitCode;
 
@@ -103,6 +106,12 @@ static bool contains(list<T> &alist, const T &val) {
 }
 
 
+int LandmarkFactoryHM::get_set_index(const FluentSet &fs) const {
+    auto it = rank_to_set_index.find(tuple_index->get_rank(fs));
+    assert(it != rank_to_set_index.end());
+    return it->second;
+}
+
 // find partial variable assignments with size m or less
 // (look at all the variables in the problem)
 void LandmarkFactoryHM::get_m_sets_(const VariablesProxy &variables, int m, int num_included, int current_var,
@@ -486,8 +495,7 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
         unsat_pc_count_[op.get_id()].first = pc_subsets.size();
 
         for (const FluentSet &pc_subset : pc_subsets) {
-            assert(set_indices_.find(pc_subset) != set_indices_.end());
-            set_index = set_indices_[pc_subset];
+            set_index = get_set_index(pc_subset);
             pm_op.pc.push_back(set_index);
             h_m_table_[set_index].pc_for.emplace_back(op.get_id(), -1);
         }
@@ -498,8 +506,7 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
         pm_op.eff.reserve(eff_subsets.size());
 
         for (const FluentSet &eff_subset : eff_subsets) {
-            assert(set_indices_.find(eff_subset) != set_indices_.end());
-            set_index = set_indices_[eff_subset];
+            set_index = get_set_index(eff_subset);
             pm_op.eff.push_back(set_index);
         }
 
@@ -509,10 +516,9 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
         // they conflict with the effect of the operator (no need to check pc
         // because mvvs appearing in pc also appear in effect
 
-        FluentSetToIntMap::const_iterator it = set_indices_.begin();
-        while (static_cast<int>(it->first.size()) < m_
-               && it != set_indices_.end()) {
-            if (possible_noop_set(variables, eff, it->first)) {
+        for (int small_set_index : small_set_indices) {
+            const FluentSet &small_set = h_m_table_[small_set_index].fluents;
+            if (possible_noop_set(variables, eff, small_set)) {
                 // for each such set, add a "conditional effect" to the operator
                 pm_op.cond_noops.resize(pm_op.cond_noops.size() + 1);
 
@@ -524,8 +530,8 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
                 // get the subsets that have >= 1 element in the pc (unless pc is empty)
                 // and >= 1 element in the other set
 
-                get_split_m_sets(variables, m_, noop_pc_subsets, pc, it->first);
-                get_split_m_sets(variables, m_, noop_eff_subsets, eff, it->first);
+                get_split_m_sets(variables, m_, noop_pc_subsets, pc, small_set);
+                get_split_m_sets(variables, m_, noop_eff_subsets, eff, small_set);
 
                 this_cond_noop.reserve(noop_pc_subsets.size() + noop_eff_subsets.size() + 1);
 
@@ -534,9 +540,8 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
                 // push back all noop preconditions
                 for (size_t j = 0; j < noop_pc_subsets.size(); ++j) {
                     assert(static_cast<int>(noop_pc_subsets[j].size()) <= m_);
-                    assert(set_indices_.find(noop_pc_subsets[j]) != set_indices_.end());
 
-                    set_index = set_indices_[noop_pc_subsets[j]];
+                    set_index = get_set_index(noop_pc_subsets[j]);
                     this_cond_noop.push_back(set_index);
                     // these facts are "conditional pcs" for this action
                     h_m_table_[set_index].pc_for.emplace_back(op.get_id(), noop_index);
@@ -548,15 +553,13 @@ void LandmarkFactoryHM::build_pm_ops(const TaskProxy &task_proxy) {
                 // and the noop effects
                 for (size_t j = 0; j < noop_eff_subsets.size(); ++j) {
                     assert(static_cast<int>(noop_eff_subsets[j].size()) <= m_);
-                    assert(set_indices_.find(noop_eff_subsets[j]) != set_indices_.end());
 
-                    set_index = set_indices_[noop_eff_subsets[j]];
+                    set_index = get_set_index(noop_eff_subsets[j]);
                     this_cond_noop.push_back(set_index);
                 }
 
                 ++noop_index;
             }
-            ++it;
         }
         print_pm_op(variables, pm_op);
     }
@@ -589,11 +592,22 @@ void LandmarkFactoryHM::initialize(const TaskProxy &task_proxy) {
     get_m_sets(task_proxy.get_variables(), m_, msets);
 
     // map each set to an integer
+    tuple_index = utils::make_unique_ptr<fact_tuple_index::FactTupleIndex>(
+        task_proxy.get_variables(), m_);
+    rank_to_set_index.reserve(msets.size());
     for (size_t i = 0; i < msets.size(); ++i) {
         h_m_table_.emplace_back();
-        set_indices_[msets[i]] = i;
+        rank_to_set_index[tuple_index->get_rank(msets[i])] = i;
         h_m_table_[i].fluents = msets[i];
+        if (static_cast<int>(msets[i].size()) < m_) {
+            small_set_indices.push_back(i);
+        }
     }
+    sort(small_set_indices.begin(), small_set_indices.end(),
+         [this](int index1, int index2) {
+             return FluentSetComparer()(
+                 h_m_table_[index1].fluents, h_m_table_[index2].fluents);
+         });
     if (log.is_at_least_normal()) {
         log << "Using " << h_m_table_.size() << " P^m fluents." << endl;
     }
@@ -690,7 +704,9 @@ void LandmarkFactoryHM::free_unneeded_memory() {
     utils::release_vector_memory(pm_ops_);
     utils::release_vector_memory(unsat_pc_count_);
 
-    set_indices_.clear();
+    tuple_index = nullptr;
+    utils::HashMap<int, int>().swap(rank_to_set_index);
+    utils::release_vector_memory(small_set_indices);
     lm_node_table_.clear();
 }
 
@@ -740,7 +756,7 @@ void LandmarkFactoryHM::compute_h_m_landmarks(const TaskProxy &task_proxy) {
 
     // for all of the initial state <= m subsets, mark level = 0
     for (size_t i = 0; i < init_subsets.size(); ++i) {
-        int index = set_indices_[init_subsets[i]];
+        int index = get_set_index(init_subsets[i]);
         h_m_table_[index].level = 0;
 
         // set actions to be applied
@@ -948,9 +964,7 @@ void LandmarkFactoryHM::generate_landmarks(
     get_m_sets(variables, m_, goal_subsets, goals);
     list<int> all_lms;
     for (const FluentSet &goal_subset : goal_subsets) {
-        assert(set_indices_.find(goal_subset) != set_indices_.end());
-
-        int set_index = set_indices_[goal_subset];
+        int set_index = get_set_index(goal_subset);
 
         if (h_m_table_[set_index].level == -1) {
             if (log.is_at_least_verbose()) {
@@ -3,6 +3,9 @@
 
 #include "landmark_factory.h"
 
+#include "../task_utils/fact_tuple_index.h"
+#include "../utils/hash.h"
+
 namespace landmarks {
 using FluentSet = std::vector<FactPair>;
 
@@ -54,8 +57,6 @@ struct HMEntry {
     }
 };
 
-using FluentSetToIntMap = std::map<FluentSet, int, FluentSetComparer>;
-
 class LandmarkFactoryHM : public LandmarkFactory {
     using TriggerSet = std::unordered_map<int, std::set<int>>;
 
@@ -86,6 +87,7 @@ class LandmarkFactoryHM : public LandmarkFactory {
     void calc_achievers(const TaskProxy &task_proxy);
 
     void add_lm_node(int set_index, bool goal = false);
+    int get_set_index(const FluentSet &fs) const;
 
     void initialize(const TaskProxy &task_proxy);
     void free_unneeded_memory();
@@ -101,8 +103,13 @@ class LandmarkFactoryHM : public LandmarkFactory {
 
     std::vector<HMEntry> h_m_table_;
     std::vector<PMOp> pm_ops_;
-    // maps each <m set to an int
-    FluentSetToIntMap set_indices_;
+    /* maps the rank of each <=m set to its index in h_m_table_. We use a
+       hash map since most ranks belong to sets with several facts of the
+       same variable, which are not in h_m_table_. */
+    std::unique_ptr<fact_tuple_index::FactTupleIndex> tuple_index;
+    utils::HashMap<int, int> rank_to_set_index;
+    // indices of the sets of size <m, ordered by FluentSetComparer
+    std::vector<int> small_set_indices;
     // first is unsat pcs for operator
     // second is unsat pcs for conditional noops
     std::vector<std::pair<int, std::vector<int>>> unsat_pc_count_;
@@ -13,7 +13,7 @@ namespace landmarks {
 */
 LandmarkStatusManager::LandmarkStatusManager(LandmarkGraph &graph)
     : lm_graph(graph),
-      reached_lms(vector<bool>(graph.get_num_landmarks(), true)),
+      reached_lms(vector<bool>(graph.get_num_landmarks(), true), "reached_landmarks"),
       lm_status(graph.get_num_landmarks(), lm_not_reached) {
 }
 
@@ -23,49 +23,74 @@ MergeScoringFunctionMIASM::MergeScoringFunctionMIASM(
       max_states(options.get<int>("max_states")),
       max_states_before_merge(options.get<int>("max_states_before_merge")),
       shrink_threshold_before_merge(options.get<int>("threshold_before_merge")),
+      use_caching(options.get<bool>("use_caching")),
       silent_log(utils::get_silent_log()) {
 }
 
+double MergeScoringFunctionMIASM::compute_score(
+    const FactoredTransitionSystem &fts, int index1, int index2) {
+    unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
+        fts,
+        index1,
+        index2,
+        *shrink_strategy,
+        max_states,
+        max_states_before_merge,
+        shrink_threshold_before_merge,
+        silent_log);
+
+    // Compute distances for the product and count the alive states.
+    unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
+    const bool compute_init_distances = true;
+    const bool compute_goal_distances = true;
+    distances->compute_distances(compute_init_distances, compute_goal_distances, silent_log);
+    int num_states = product->get_size();
+    int alive_states_count = 0;
+    for (int state = 0; state < num_states; ++state) {
+        if (distances->get_init_distance(state) != INF &&
+            distances->get_goal_distance(state) != INF) {
+            ++alive_states_count;
+        }
+    }
+
+    /*
+      Compute the score as the ratio of alive states of the product
+      compared to the number of states of the full product.
+    */
+    assert(num_states);
+    return static_cast<double>(alive_states_count) /
+           static_cast<double>(num_states);
+}
+
 vector<double> MergeScoringFunctionMIASM::compute_scores(
     const FactoredTransitionSystem &fts,
     const vector<pair<int, int>> &merge_candidates) {
+    if (use_caching) {
+        // Forget the scores of candidates with factors that have been merged.
+        for (auto it = cached_scores.begin(); it != cached_scores.end();) {
+            if (fts.is_active(it->first.first) && fts.is_active(it->first.second)) {
+                ++it;
+            } else {
+                it = cached_scores.erase(it);
+            }
+        }
+    }
+
     vector<double> scores;
     scores.reserve(merge_candidates.size());
     for (pair<int, int> merge_candidate : merge_candidates) {
         int index1 = merge_candidate.first;
         int index2 = merge_candidate.second;
-        unique_ptr<TransitionSystem> product = shrink_before_merge_externally(
-            fts,
-            index1,
-            index2,
-            *shrink_strategy,
-            max_states,
-            max_states_before_merge,
-            shrink_threshold_before_merge,
-            silent_log);
-
-        // Compute distances for the product and count the alive states.
-        unique_ptr<Distances> distances = utils::make_unique_ptr<Distances>(*product);
-        const bool compute_init_distances = true;
-        const bool compute_goal_distances = true;
-        distances->compute_distances(compute_init_distances, compute_goal_distances, silent_log);
-        int num_states = product->get_size();
-        int alive_states_count = 0;
-        for (int state = 0; state < num_states; ++state) {
-            if (distances->get_init_distance(state) != INF &&
-                distances->get_goal_distance(state) != INF) {
-                ++alive_states_count;
+        if (use_caching) {
+            auto it = cached_scores.find(merge_candidate);
+            if (it == cached_scores.end()) {
+                it = cached_scores.emplace(
+                    merge_candidate, compute_score(fts, index1, index2)).first;
             }
+            scores.push_back(it->second);
+        } else {
+            scores.push_back(compute_score(fts, index1, index2));
         }
-
-        /*
-          Compute the score as the ratio of alive states of the product
-          compared to the number of states of the full product.
-        */
-        assert(num_states);
-        double score = static_cast<double>(alive_states_count) /
-            static_cast<double>(num_states);
-        scores.push_back(score);
     }
     return scores;
 }
@@ -74,6 +99,13 @@ string MergeScoringFunctionMIASM::name() const {
     return "miasm";
 }
 
+void MergeScoringFunctionMIASM::dump_function_specific_options(
+    utils::LogProxy &log) const {
+    if (log.is_at_least_normal()) {
+        log << "Use caching: " << (use_caching ? "yes" : "no") << endl;
+    }
+}
+
 static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
     parser.document_synopsis(
         "MIASM",
@@ -127,6 +159,15 @@ static shared_ptr<MergeScoringFunction>_parse(options::OptionParser &parser) {
         "We recommend setting this to match the shrink strategy configuration "
         "given to {{{merge_and_shrink}}}, see note below.");
     add_transition_system_size_limit_options_to_parser(parser);
+    parser.add_option<bool>(
+        "use_caching",
+        "Cache the scores of merge candidates across iterations, so that only "
+        "the candidates involving the most recently merged factor need to be "
+        "scored. IMPORTANT! This assumes that merge-and-shrink only uses exact "
+        "label reduction and does not shrink factors other than the two that "
+        "are merged in the current iteration. Under these conditions, the "
+        "MIASM score of a merge candidate does not change over iterations.",
+        "true");
     // TODO: this is only necessary for handle_shrink_limit_options_defaults.
     utils::add_log_options_to_parser(parser);
 
@@ -3,6 +3,7 @@
 
 #include "merge_scoring_function.h"
 
+#include "../utils/hash.h"
 #include "../utils/logging.h"
 
 #include <memory>
@@ -14,9 +15,20 @@ class MergeScoringFunctionMIASM : public MergeScoringFunction {
     const int max_states;
     const int max_states_before_merge;
     const int shrink_threshold_before_merge;
+    const bool use_caching;
     utils::LogProxy silent_log;
+    /*
+      Scores of merge candidates computed in earlier iterations. Factors
+      keep their index until they are merged, and merged factors get a new
+      index, so only candidates involving the most recent product are
+      missing from the cache.
+    */
+    utils::HashMap<std::pair<int, int>, double> cached_scores;
+
+    double compute_score(const FactoredTransitionSystem &fts, int index1, int index2);
 protected:
     virtual std::string name() const override;
+    virtual void dump_function_specific_options(utils::LogProxy &log) const override;
 public:
     explicit MergeScoringFunctionMIASM(const options::Options &options);
     virtual ~MergeScoringFunctionMIASM() override = default;
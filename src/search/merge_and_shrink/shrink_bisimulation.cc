@@ -28,10 +28,13 @@ namespace merge_and_shrink {
    identical successor signature are not distinguished by
    bisimulation.
 
-   Each entry in the vector is a pair of (label group ID, equivalence class of
-   successor). The bisimulation algorithm requires that the vector is
-   sorted and uniquified. */
-using SuccessorSignature = vector<pair<int, int>>;
+   Each entry is a pair of (label group ID, equivalence class of
+   successor). The bisimulation algorithm requires that the entries of a
+   signature are sorted and uniquified. The entries of all states are
+   stored consecutively in one vector, and each signature refers to its
+   range of entries. This avoids allocating a vector per state in every
+   refinement round. */
+using SuccessorSignatureEntry = pair<int, int>;
 
 /*
   As we use SENTINEL numeric_limits<int>::max() as a sentinel signature and
@@ -52,13 +55,16 @@ const int IRRELEVANT = SENTINEL - 1;
 struct Signature {
     int h_and_goal; // -1 for goal states; h value for non-goal states
     int group;
-    SuccessorSignature succ_signature;
+    const SuccessorSignatureEntry *succ_begin;
+    const SuccessorSignatureEntry *succ_end;
     int state;
 
     Signature(int h, bool is_goal, int group_,
-              const SuccessorSignature &succ_signature_,
+              const SuccessorSignatureEntry *succ_begin_,
+              const SuccessorSignatureEntry *succ_end_,
               int state_)
-        : group(group_), succ_signature(succ_signature_), state(state_) {
+        : group(group_), succ_begin(succ_begin_), succ_end(succ_end_),
+          state(state_) {
         if (is_goal) {
             assert(h == 0);
             h_and_goal = -1;
@@ -67,13 +73,19 @@ struct Signature {
         }
     }
 
+    bool has_same_successors(const Signature &other) const {
+        return succ_end - succ_begin == other.succ_end - other.succ_begin &&
+               equal(succ_begin, succ_end, other.succ_begin);
+    }
+
     bool operator<(const Signature &other) const {
         if (h_and_goal != other.h_and_goal)
             return h_and_goal < other.h_and_goal;
         if (group != other.group)
             return group < other.group;
-        if (succ_signature != other.succ_signature)
-            return succ_signature < other.succ_signature;
+        if (!has_same_successors(other))
+            return lexicographical_compare(
+                succ_begin, succ_end, other.succ_begin, other.succ_end);
         return state < other.state;
     }
 
@@ -83,11 +95,12 @@ struct Signature {
                 << ", group = " << group
                 << ", state = " << state
                 << ", succ_sig = [";
-            for (size_t i = 0; i < succ_signature.size(); ++i) {
-                if (i)
+            for (const SuccessorSignatureEntry *entry = succ_begin;
+                 entry != succ_end; ++entry) {
+                if (entry != succ_begin)
                     log << ", ";
-                log << "(" << succ_signature[i].first
-                    << "," << succ_signature[i].second
+                log << "(" << entry->first
+                    << "," << entry->second
                     << ")";
             }
             log << "])" << endl;
@@ -143,25 +156,40 @@ void ShrinkBisimulation::compute_signatures(
     const TransitionSystem &ts,
     const Distances &distances,
     vector<Signature> &signatures,
+    vector<SuccessorSignatureEntry> &succ_signatures,
     const vector<int> &state_to_group) const {
     assert(signatures.empty());
+    int num_states = ts.get_size();
 
-    // Step 1: Compute bare state signatures (without transition information).
-    signatures.push_back(Signature(-2, false, -1, SuccessorSignature(), -1));
-    for (int state = 0; state < ts.get_size(); ++state) {
-        int h = distances.get_goal_distance(state);
-        if (h == INF) {
-            h = IRRELEVANT;
+    auto is_skipped = [&](const Transition &transition, int cost) {
+        if (!greedy) {
+            return false;
+        }
+        int src_h = distances.get_goal_distance(transition.src);
+        int target_h = distances.get_goal_distance(transition.target);
+        if (src_h == INF || target_h == INF) {
+            // We skip transitions connected to an irrelevant state.
+            return true;
+        }
+        assert(target_h + cost >= src_h);
+        return target_h + cost != src_h;
+    };
+
+    // Step 1: Compute the position of each state's successor signature.
+    vector<int> succ_signature_start(num_states + 1, 0);
+    for (GroupAndTransitions gat : ts) {
+        int cost = gat.label_group.get_cost();
+        for (const Transition &transition : gat.transitions) {
+            if (!is_skipped(transition, cost)) {
+                ++succ_signature_start[transition.src + 1];
+            }
         }
-        Signature signature(h, ts.is_goal_state(state),
-                            state_to_group[state], SuccessorSignature(),
-                            state);
-        signatures.push_back(signature);
     }
-    signatures.push_back(Signature(SENTINEL, false, -1, SuccessorSignature(), -1));
+    for (int state = 0; state < num_states; ++state) {
+        succ_signature_start[state + 1] += succ_signature_start[state];
+    }
 
     // Step 2: Add transition information.
-    int label_group_counter = 0;
     /*
       Note that the final result of the bisimulation may depend on the
       order in which transitions are considered below.
@@ -186,29 +214,18 @@ void ShrinkBisimulation::compute_signatures(
                                                 threshold=1),
             label_reduction=exact(before_shrinking=true,before_merging=false)))
     */
+    succ_signatures.resize(succ_signature_start[num_states]);
+    vector<int> succ_signature_end(
+        succ_signature_start.begin(), succ_signature_start.end() - 1);
+    int label_group_counter = 0;
     for (GroupAndTransitions gat : ts) {
-        const LabelGroup &label_group = gat.label_group;
-        const vector<Transition> &transitions = gat.transitions;
-        for (const Transition &transition : transitions) {
-            assert(signatures[transition.src + 1].state == transition.src);
-            bool skip_transition = false;
-            if (greedy) {
-                int src_h = distances.get_goal_distance(transition.src);
-                int target_h = distances.get_goal_distance(transition.target);
-                if (src_h == INF || target_h == INF) {
-                    // We skip transitions connected to an irrelevant state.
-                    skip_transition = true;
-                } else {
-                    int cost = label_group.get_cost();
-                    assert(target_h + cost >= src_h);
-                    skip_transition = (target_h + cost != src_h);
-                }
-            }
-            if (!skip_transition) {
+        int cost = gat.label_group.get_cost();
+        for (const Transition &transition : gat.transitions) {
+            if (!is_skipped(transition, cost)) {
                 int target_group = state_to_group[transition.target];
                 assert(target_group != -1 && target_group != SENTINEL);
-                signatures[transition.src + 1].succ_signature.push_back(
-                    make_pair(label_group_counter, target_group));
+                succ_signatures[succ_signature_end[transition.src]++] =
+                    make_pair(label_group_counter, target_group);
             }
         }
         ++label_group_counter;
@@ -228,13 +245,24 @@ void ShrinkBisimulation::compute_signatures(
           iff we don't want to distinguish their states in the current
           bisimulation round.
      */
+    signatures.push_back(Signature(-2, false, -1, nullptr, nullptr, -1));
+    for (int state = 0; state < num_states; ++state) {
+        SuccessorSignatureEntry *succ_begin =
+            succ_signatures.data() + succ_signature_start[state];
+        SuccessorSignatureEntry *succ_end =
+            succ_signatures.data() + succ_signature_end[state];
+        ::sort(succ_begin, succ_end);
+        succ_end = ::unique(succ_begin, succ_end);
 
-    for (size_t i = 0; i < signatures.size(); ++i) {
-        SuccessorSignature &succ_sig = signatures[i].succ_signature;
-        ::sort(succ_sig.begin(), succ_sig.end());
-        succ_sig.erase(::unique(succ_sig.begin(), succ_sig.end()),
-                       succ_sig.end());
+        int h = distances.get_goal_distance(state);
+        if (h == INF) {
+            h = IRRELEVANT;
+        }
+        signatures.push_back(
+            Signature(h, ts.is_goal_state(state), state_to_group[state],
+                      succ_begin, succ_end, state));
     }
+    signatures.push_back(Signature(SENTINEL, false, -1, nullptr, nullptr, -1));
 
     ::sort(signatures.begin(), signatures.end());
 }
@@ -250,6 +278,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
     vector<int> state_to_group(num_states);
     vector<Signature> signatures;
     signatures.reserve(num_states + 2);
+    vector<SuccessorSignatureEntry> succ_signatures;
 
     int num_groups = initialize_groups(ts, distances, state_to_group);
     // log << "number of initial groups: " << num_groups << endl;
@@ -263,7 +292,8 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
         stable = true;
 
         signatures.clear();
-        compute_signatures(ts, distances, signatures, state_to_group);
+        compute_signatures(
+            ts, distances, signatures, succ_signatures, state_to_group);
 
         // Verify size of signatures and presence of sentinels.
         assert(static_cast<int>(signatures.size()) == num_states + 2);
@@ -298,7 +328,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
                 if (prev_sig.group != curr_sig.group) {
                     ++num_old_groups;
                     ++num_new_groups;
-                } else if (prev_sig.succ_signature != curr_sig.succ_signature) {
+                } else if (!prev_sig.has_same_successors(curr_sig)) {
                     ++num_new_groups;
                 }
             }
@@ -324,8 +354,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
                     if (prev_sig.group != curr_sig.group) {
                         // Start first group of a block; keep old group no.
                         new_group_no = curr_sig.group;
-                    } else if (prev_sig.succ_signature
-                               != curr_sig.succ_signature) {
+                    } else if (!prev_sig.has_same_successors(curr_sig)) {
                         new_group_no = num_groups++;
                         assert(num_groups <= target_size);
                     }
@@ -346,6 +375,7 @@ StateEquivalenceRelation ShrinkBisimulation::compute_equivalence_relation(
        relation since this is one of the code parts relevant to peak
        memory. */
     utils::release_vector_memory(signatures);
+    utils::release_vector_memory(succ_signatures);
 
     // Generate final result.
     StateEquivalenceRelation equivalence_relation;
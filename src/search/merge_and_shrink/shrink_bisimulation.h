@@ -3,6 +3,8 @@
 
 #include "shrink_strategy.h"
 
+#include <utility>
+
 namespace options {
 class Options;
 }
@@ -34,6 +36,7 @@ class ShrinkBisimulation : public ShrinkStrategy {
         const TransitionSystem &ts,
         const Distances &distances,
         std::vector<Signature> &signatures,
+        std::vector<std::pair<int, int>> &succ_signatures,
         const std::vector<int> &state_to_group) const;
 protected:
     virtual void dump_strategy_specific_options(utils::LogProxy &log) const override;
@@ -13,7 +13,6 @@
 #include <cassert>
 #include <iostream>
 #include <iterator>
-#include <set>
 #include <sstream>
 #include <string>
 #include <unordered_map>
@@ -28,10 +27,15 @@ ostream &operator<<(ostream &os, const Transition &trans) {
     return os;
 }
 
-// Sorts the given set of transitions and removes duplicates.
+/*
+  Sorts the given set of transitions and removes duplicates. Transitions
+  make up most of the memory of a transition system, so we also release
+  the capacity that was reserved for the removed duplicates.
+*/
 static void normalize_given_transitions(vector<Transition> &transitions) {
     sort(transitions.begin(), transitions.end());
     transitions.erase(unique(transitions.begin(), transitions.end()), transitions.end());
+    transitions.shrink_to_fit();
 }
 
 TSConstIterator::TSConstIterator(
@@ -133,7 +137,6 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
         back_inserter(incorporated_variables));
     vector<vector<int>> label_groups;
     vector<vector<Transition>> transitions_by_group_id;
-    transitions_by_group_id.reserve(labels.get_max_size());
 
     int ts1_size = ts1.get_size();
     int ts2_size = ts2.get_size();
@@ -188,15 +191,37 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
                 && transitions1.size() > new_transitions.max_size() / transitions2.size())
                 utils::exit_with(ExitCode::SEARCH_OUT_OF_MEMORY);
             new_transitions.reserve(transitions1.size() * transitions2.size());
-            for (const Transition &transition1 : transitions1) {
-                int src1 = transition1.src;
-                int target1 = transition1.target;
-                for (const Transition &transition2 : transitions2) {
-                    int src2 = transition2.src;
-                    int target2 = transition2.target;
+            /*
+              Both transition vectors are sorted. Combining all transitions
+              of one source state in ts1 with all transitions of one source
+              state in ts2 at a time yields the product transitions in
+              sorted order, so we do not need to sort them afterwards.
+            */
+            int num_transitions1 = transitions1.size();
+            int num_transitions2 = transitions2.size();
+            int run1_end;
+            for (int run1_start = 0; run1_start < num_transitions1;
+                 run1_start = run1_end) {
+                int src1 = transitions1[run1_start].src;
+                for (run1_end = run1_start; run1_end < num_transitions1 &&
+                     transitions1[run1_end].src == src1; ++run1_end) {
+                }
+                int run2_end;
+                for (int run2_start = 0; run2_start < num_transitions2;
+                     run2_start = run2_end) {
+                    int src2 = transitions2[run2_start].src;
+                    for (run2_end = run2_start; run2_end < num_transitions2 &&
+                         transitions2[run2_end].src == src2; ++run2_end) {
+                    }
                     int src = src1 * multiplier + src2;
-                    int target = target1 * multiplier + target2;
-                    new_transitions.push_back(Transition(src, target));
+                    for (int i = run1_start; i < run1_end; ++i) {
+                        int target1 = transitions1[i].target;
+                        for (int j = run2_start; j < run2_end; ++j) {
+                            int target2 = transitions2[j].target;
+                            int target = target1 * multiplier + target2;
+                            new_transitions.push_back(Transition(src, target));
+                        }
+                    }
                 }
             }
 
@@ -205,7 +230,7 @@ unique_ptr<TransitionSystem> TransitionSystem::merge(
             if (new_transitions.empty()) {
                 dead_labels.insert(dead_labels.end(), new_labels.begin(), new_labels.end());
             } else {
-                sort(new_transitions.begin(), new_transitions.end());
+                assert(is_sorted(new_transitions.begin(), new_transitions.end()));
                 label_groups.push_back(move(new_labels));
                 transitions_by_group_id.push_back(move(new_transitions));
             }
@@ -379,17 +404,18 @@ void TransitionSystem::apply_label_reduction(
             const vector<int> &old_label_nos = mapping.second;
             assert(old_label_nos.size() >= 2);
             unordered_set<int> seen_group_ids;
-            set<Transition> new_label_transitions;
+            vector<Transition> new_label_transitions;
             for (int old_label_no : old_label_nos) {
                 int group_id = label_equivalence_relation->get_group_id(old_label_no);
                 if (seen_group_ids.insert(group_id).second) {
                     affected_group_ids.insert(group_id);
                     const vector<Transition> &transitions = transitions_by_group_id[group_id];
-                    new_label_transitions.insert(transitions.begin(), transitions.end());
+                    new_label_transitions.insert(
+                        new_label_transitions.end(), transitions.begin(), transitions.end());
                 }
             }
-            new_transitions.emplace_back(
-                new_label_transitions.begin(), new_label_transitions.end());
+            normalize_given_transitions(new_label_transitions);
+            new_transitions.push_back(move(new_label_transitions));
         }
         assert(label_mapping.size() == new_transitions.size());
 
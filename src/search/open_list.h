@@ -6,6 +6,8 @@
 #include "evaluation_context.h"
 #include "operator_id.h"
 
+#include "utils/profiling.h"
+
 class StateID;
 
 
@@ -55,6 +57,13 @@ public:
     // Return true if the open list is empty.
     virtual bool empty() const = 0;
 
+    /*
+      Return the number of entries that remove_min can still return.
+      Entries that are stored several times (e.g., in several sublists)
+      are counted several times.
+    */
+    virtual int get_num_entries() const = 0;
+
     /*
       Remove all elements from the open list.
 
@@ -147,8 +156,10 @@ void OpenList<Entry>::insert(
     EvaluationContext &eval_context, const Entry &entry) {
     if (only_preferred && !eval_context.is_preferred())
         return;
-    if (!is_dead_end(eval_context))
+    if (!is_dead_end(eval_context)) {
+        PROFILE_SCOPE("open list insertion");
         do_insertion(eval_context, entry);
+    }
 }
 
 template<class Entry>
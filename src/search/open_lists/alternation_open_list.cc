@@ -5,6 +5,7 @@
 #include "../plugin.h"
 
 #include "../utils/memory.h"
+#include "../utils/profiling.h"
 #include "../utils/system.h"
 
 #include <cassert>
@@ -31,6 +32,7 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual void boost_preferred() override;
     virtual void get_path_dependent_evaluators(
@@ -63,6 +65,7 @@ void AlternationOpenList<Entry>::do_insertion(
 
 template<class Entry>
 Entry AlternationOpenList<Entry>::remove_min() {
+    PROFILE_SCOPE("open list removal");
     int best = -1;
     for (size_t i = 0; i < open_lists.size(); ++i) {
         if (!open_lists[i]->empty() &&
@@ -85,6 +88,14 @@ bool AlternationOpenList<Entry>::empty() const {
     return true;
 }
 
+template<class Entry>
+int AlternationOpenList<Entry>::get_num_entries() const {
+    int num_entries = 0;
+    for (const auto &sublist : open_lists)
+        num_entries += sublist->get_num_entries();
+    return num_entries;
+}
+
 template<class Entry>
 void AlternationOpenList<Entry>::clear() {
     for (const auto &sublist : open_lists)
@@ -6,6 +6,7 @@
 #include "../plugin.h"
 
 #include "../utils/memory.h"
+#include "../utils/profiling.h"
 
 #include <cassert>
 #include <deque>
@@ -34,6 +35,7 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
@@ -68,6 +70,7 @@ void BestFirstOpenList<Entry>::do_insertion(
 
 template<class Entry>
 Entry BestFirstOpenList<Entry>::remove_min() {
+    PROFILE_SCOPE("open list removal");
     assert(size > 0);
     auto it = buckets.begin();
     assert(it != buckets.end());
@@ -86,6 +89,11 @@ bool BestFirstOpenList<Entry>::empty() const {
     return size == 0;
 }
 
+template<class Entry>
+int BestFirstOpenList<Entry>::get_num_entries() const {
+    return size;
+}
+
 template<class Entry>
 void BestFirstOpenList<Entry>::clear() {
     buckets.clear();
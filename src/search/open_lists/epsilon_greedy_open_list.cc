@@ -8,6 +8,7 @@
 #include "../utils/collections.h"
 #include "../utils/markup.h"
 #include "../utils/memory.h"
+#include "../utils/profiling.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -56,6 +57,7 @@ public:
         EvaluationContext &eval_context) const override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
 };
 
@@ -93,6 +95,7 @@ EpsilonGreedyOpenList<Entry>::EpsilonGreedyOpenList(const Options &opts)
 
 template<class Entry>
 Entry EpsilonGreedyOpenList<Entry>::remove_min() {
+    PROFILE_SCOPE("open list removal");
     assert(size > 0);
     if (rng->random() < epsilon) {
         int pos = rng->random(size);
@@ -129,6 +132,11 @@ bool EpsilonGreedyOpenList<Entry>::empty() const {
     return size == 0;
 }
 
+template<class Entry>
+int EpsilonGreedyOpenList<Entry>::get_num_entries() const {
+    return size;
+}
+
 template<class Entry>
 void EpsilonGreedyOpenList<Entry>::clear() {
     heap.clear();
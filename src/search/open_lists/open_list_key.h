@@ -0,0 +1,97 @@
+#ifndef OPEN_LISTS_OPEN_LIST_KEY_H
+#define OPEN_LISTS_OPEN_LIST_KEY_H
+
+#include "../utils/hash.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace open_list_key {
+/*
+  Evaluator values of an open list entry, compared lexicographically.
+
+  Open lists compute a key for every insertion. Since most open lists use
+  few evaluators, keys with up to INLINE_CAPACITY values are stored inside
+  the object and only longer keys allocate memory on the heap.
+*/
+class OpenListKey {
+    static const int INLINE_CAPACITY = 4;
+
+    int num_values;
+    int inline_values[INLINE_CAPACITY];
+    std::vector<int> heap_values;
+
+    bool is_inline() const {
+        return num_values <= INLINE_CAPACITY;
+    }
+
+public:
+    OpenListKey()
+        : num_values(0) {
+    }
+
+    void push_back(int value) {
+        if (num_values < INLINE_CAPACITY) {
+            inline_values[num_values] = value;
+        } else {
+            if (num_values == INLINE_CAPACITY) {
+                heap_values.assign(inline_values, inline_values + INLINE_CAPACITY);
+            }
+            heap_values.push_back(value);
+        }
+        ++num_values;
+    }
+
+    int size() const {
+        return num_values;
+    }
+
+    const int *begin() const {
+        return is_inline() ? inline_values : heap_values.data();
+    }
+
+    const int *end() const {
+        return begin() + num_values;
+    }
+
+    int operator[](int index) const {
+        assert(index >= 0 && index < num_values);
+        return begin()[index];
+    }
+
+    bool operator==(const OpenListKey &other) const {
+        return num_values == other.num_values &&
+               std::equal(begin(), end(), other.begin());
+    }
+
+    bool operator!=(const OpenListKey &other) const {
+        return !(*this == other);
+    }
+
+    bool operator<(const OpenListKey &other) const {
+        return std::lexicographical_compare(
+            begin(), end(), other.begin(), other.end());
+    }
+};
+}
+
+namespace utils {
+inline void feed(HashState &hash_state, const open_list_key::OpenListKey &key) {
+    feed(hash_state, static_cast<std::uint64_t>(key.size()));
+    for (int value : key) {
+        feed(hash_state, value);
+    }
+}
+}
+
+namespace open_list_key {
+struct OpenListKeyHash {
+    std::size_t operator()(const OpenListKey &key) const {
+        return utils::get_hash(key);
+    }
+};
+}
+
+#endif
@@ -1,5 +1,7 @@
 #include "pareto_open_list.h"
 
+#include "open_list_key.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
@@ -7,6 +9,7 @@
 
 #include "../utils/hash.h"
 #include "../utils/memory.h"
+#include "../utils/profiling.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
@@ -25,12 +28,13 @@ class ParetoOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
 
     using Bucket = deque<Entry>;
-    using KeyType = vector<int>;
+    using KeyType = open_list_key::OpenListKey;
     using BucketMap = utils::HashMap<KeyType, Bucket>;
     using KeySet = set<KeyType>;
 
     BucketMap buckets;
     KeySet nondominated;
+    int num_entries;
     bool state_uniform_selection;
     vector<shared_ptr<Evaluator>> evaluators;
 
@@ -49,6 +53,7 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
@@ -63,6 +68,7 @@ template<class Entry>
 ParetoOpenList<Entry>::ParetoOpenList(const Options &opts)
     : OpenList<Entry>(opts.get<bool>("pref_only")),
       rng(utils::parse_rng_from_options(opts)),
+      num_entries(0),
       state_uniform_selection(opts.get<bool>("state_uniform_selection")),
       evaluators(opts.get_list<shared_ptr<Evaluator>>("evals")) {
 }
@@ -72,7 +78,7 @@ bool ParetoOpenList<Entry>::dominates(
     const KeyType &v1, const KeyType &v2) const {
     assert(v1.size() == v2.size());
     bool are_different = false;
-    for (size_t i = 0; i < v1.size(); ++i) {
+    for (int i = 0; i < v1.size(); ++i) {
         if (v1[i] > v2[i])
             return false;
         else if (v1[i] < v2[i])
@@ -97,7 +103,7 @@ void ParetoOpenList<Entry>::remove_key(const KeyType &key) {
       data structures from which we remove it here and hence becomes
       invalid at that point.
     */
-    vector<int> copied_key(key);
+    KeyType copied_key(key);
     nondominated.erase(copied_key);
     buckets.erase(copied_key);
     KeySet candidates;
@@ -123,14 +129,14 @@ void ParetoOpenList<Entry>::remove_key(const KeyType &key) {
 template<class Entry>
 void ParetoOpenList<Entry>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size());
+    KeyType key;
     for (const shared_ptr<Evaluator> &evaluator : evaluators)
         key.push_back(eval_context.get_evaluator_value_or_infinity(evaluator.get()));
 
     Bucket &bucket = buckets[key];
     bool newkey = bucket.empty();
     bucket.push_back(entry);
+    ++num_entries;
 
     if (newkey && is_nondominated(key, nondominated)) {
         /*
@@ -158,6 +164,7 @@ void ParetoOpenList<Entry>::do_insertion(
 
 template<class Entry>
 Entry ParetoOpenList<Entry>::remove_min() {
+    PROFILE_SCOPE("open list removal");
     typename KeySet::iterator selected = nondominated.begin();
     int seen = 0;
     for (typename KeySet::iterator it = nondominated.begin();
@@ -174,6 +181,7 @@ Entry ParetoOpenList<Entry>::remove_min() {
     Bucket &bucket = buckets[*selected];
     Entry result = bucket.front();
     bucket.pop_front();
+    --num_entries;
     if (bucket.empty())
         remove_key(*selected);
     return result;
@@ -184,10 +192,16 @@ bool ParetoOpenList<Entry>::empty() const {
     return nondominated.empty();
 }
 
+template<class Entry>
+int ParetoOpenList<Entry>::get_num_entries() const {
+    return num_entries;
+}
+
 template<class Entry>
 void ParetoOpenList<Entry>::clear() {
     buckets.clear();
     nondominated.clear();
+    num_entries = 0;
 }
 
 template<class Entry>
@@ -1,11 +1,14 @@
 #include "tiebreaking_open_list.h"
 
+#include "open_list_key.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
 #include "../utils/memory.h"
+#include "../utils/profiling.h"
 
 #include <cassert>
 #include <deque>
@@ -18,9 +21,10 @@ using namespace std;
 namespace tiebreaking_open_list {
 template<class Entry>
 class TieBreakingOpenList : public OpenList<Entry> {
+    using Key = open_list_key::OpenListKey;
     using Bucket = deque<Entry>;
 
-    map<const vector<int>, Bucket> buckets;
+    map<const Key, Bucket> buckets;
     int size;
 
     vector<shared_ptr<Evaluator>> evaluators;
@@ -43,6 +47,7 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual void get_path_dependent_evaluators(set<Evaluator *> &evals) override;
     virtual bool is_dead_end(
@@ -62,8 +67,7 @@ TieBreakingOpenList<Entry>::TieBreakingOpenList(const Options &opts)
 template<class Entry>
 void TieBreakingOpenList<Entry>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size());
+    Key key;
     for (const shared_ptr<Evaluator> &evaluator : evaluators)
         key.push_back(eval_context.get_evaluator_value_or_infinity(evaluator.get()));
 
@@ -73,8 +77,9 @@ void TieBreakingOpenList<Entry>::do_insertion(
 
 template<class Entry>
 Entry TieBreakingOpenList<Entry>::remove_min() {
+    PROFILE_SCOPE("open list removal");
     assert(size > 0);
-    typename map<const vector<int>, Bucket>::iterator it;
+    typename map<const Key, Bucket>::iterator it;
     it = buckets.begin();
     assert(it != buckets.end());
     assert(!it->second.empty());
@@ -91,6 +96,11 @@ bool TieBreakingOpenList<Entry>::empty() const {
     return size == 0;
 }
 
+template<class Entry>
+int TieBreakingOpenList<Entry>::get_num_entries() const {
+    return size;
+}
+
 template<class Entry>
 void TieBreakingOpenList<Entry>::clear() {
     buckets.clear();
@@ -1,19 +1,21 @@
 #include "type_based_open_list.h"
 
+#include "open_list_key.h"
+
 #include "../evaluator.h"
 #include "../open_list.h"
 #include "../option_parser.h"
 #include "../plugin.h"
 
 #include "../utils/collections.h"
-#include "../utils/hash.h"
 #include "../utils/markup.h"
 #include "../utils/memory.h"
+#include "../utils/profiling.h"
 #include "../utils/rng.h"
 #include "../utils/rng_options.h"
 
 #include <memory>
-#include <unordered_map>
+#include <parallel_hashmap/phmap.h>
 #include <vector>
 
 using namespace std;
@@ -24,10 +26,12 @@ class TypeBasedOpenList : public OpenList<Entry> {
     shared_ptr<utils::RandomNumberGenerator> rng;
     vector<shared_ptr<Evaluator>> evaluators;
 
-    using Key = vector<int>;
+    using Key = open_list_key::OpenListKey;
     using Bucket = vector<Entry>;
     vector<pair<Key, Bucket>> keys_and_buckets;
-    utils::HashMap<Key, int> key_to_bucket_index;
+    phmap::flat_hash_map<Key, int, open_list_key::OpenListKeyHash>
+    key_to_bucket_index;
+    int num_entries;
 
 protected:
     virtual void do_insertion(
@@ -39,6 +43,7 @@ public:
 
     virtual Entry remove_min() override;
     virtual bool empty() const override;
+    virtual int get_num_entries() const override;
     virtual void clear() override;
     virtual bool is_dead_end(EvaluationContext &eval_context) const override;
     virtual bool is_reliable_dead_end(
@@ -49,8 +54,7 @@ public:
 template<class Entry>
 void TypeBasedOpenList<Entry>::do_insertion(
     EvaluationContext &eval_context, const Entry &entry) {
-    vector<int> key;
-    key.reserve(evaluators.size());
+    Key key;
     for (const shared_ptr<Evaluator> &evaluator : evaluators) {
         key.push_back(
             eval_context.get_evaluator_value_or_infinity(evaluator.get()));
@@ -65,22 +69,26 @@ void TypeBasedOpenList<Entry>::do_insertion(
         assert(utils::in_bounds(bucket_index, keys_and_buckets));
         keys_and_buckets[bucket_index].second.push_back(entry);
     }
+    ++num_entries;
 }
 
 template<class Entry>
 TypeBasedOpenList<Entry>::TypeBasedOpenList(const Options &opts)
     : rng(utils::parse_rng_from_options(opts)),
-      evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")) {
+      evaluators(opts.get_list<shared_ptr<Evaluator>>("evaluators")),
+      num_entries(0) {
 }
 
 template<class Entry>
 Entry TypeBasedOpenList<Entry>::remove_min() {
+    PROFILE_SCOPE("open list removal");
     size_t bucket_id = rng->random(keys_and_buckets.size());
     auto &key_and_bucket = keys_and_buckets[bucket_id];
     const Key &min_key = key_and_bucket.first;
     Bucket &bucket = key_and_bucket.second;
     int pos = rng->random(bucket.size());
     Entry result = utils::swap_and_pop_from_vector(bucket, pos);
+    --num_entries;
 
     if (bucket.empty()) {
         // Swap the empty bucket with the last bucket, then delete it.
@@ -96,10 +104,16 @@ bool TypeBasedOpenList<Entry>::empty() const {
     return keys_and_buckets.empty();
 }
 
+template<class Entry>
+int TypeBasedOpenList<Entry>::get_num_entries() const {
+    return num_entries;
+}
+
 template<class Entry>
 void TypeBasedOpenList<Entry>::clear() {
     keys_and_buckets.clear();
     key_to_bucket_index.clear();
+    num_entries = 0;
 }
 
 template<class Entry>
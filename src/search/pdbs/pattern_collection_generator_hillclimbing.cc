@@ -203,6 +203,7 @@ void PatternCollectionGeneratorHillclimbing::sample_states(
 pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
     const vector<State> &samples,
     const vector<int> &samples_h_values,
+    const vector<vector<int>> &samples_pdb_values,
     PDBCollection &candidate_pdbs) {
     /*
       TODO: The original implementation by Haslum et al. uses A* to compute
@@ -254,7 +255,7 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
             int h_collection = samples_h_values[sample_id];
             if (is_heuristic_improved(
                     *pdb, sample, h_collection,
-                    *current_pdbs->get_pattern_databases(), pattern_cliques)) {
+                    samples_pdb_values[sample_id], pattern_cliques)) {
                 ++count;
             }
         }
@@ -273,7 +274,7 @@ pair<int, int> PatternCollectionGeneratorHillclimbing::find_best_improving_pdb(
 
 bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
     const PatternDatabase &pdb, const State &sample, int h_collection,
-    const PDBCollection &pdbs, const vector<PatternClique> &pattern_cliques) {
+    const vector<int> &pdb_values, const vector<PatternClique> &pattern_cliques) {
     const vector<int> &sample_data = sample.get_unpacked_values();
     // h_pattern: h-value of the new pattern
     int h_pattern = pdb.get_value(sample_data);
@@ -282,22 +283,19 @@ bool PatternCollectionGeneratorHillclimbing::is_heuristic_improved(
         return true;
     }
 
-    // h_collection: h-value of the current collection heuristic
+    /*
+      h_collection: h-value of the current collection heuristic. It is
+      infinite iff one of the PDBs in the collection has an infinite value,
+      so all values in pdb_values are finite below.
+    */
     if (h_collection == numeric_limits<int>::max())
         return false;
 
-    vector<int> h_values;
-    h_values.reserve(pdbs.size());
-    for (const shared_ptr<PatternDatabase> &p : pdbs) {
-        int h = p->get_value(sample_data);
-        if (h == numeric_limits<int>::max())
-            return false;
-        h_values.push_back(h);
-    }
     for (const PatternClique &clilque : pattern_cliques) {
         int h_clique = 0;
         for (PatternID pattern_id : clilque) {
-            h_clique += h_values[pattern_id];
+            assert(pdb_values[pattern_id] != numeric_limits<int>::max());
+            h_clique += pdb_values[pattern_id];
         }
         if (h_pattern + h_clique > h_collection) {
             /*
@@ -353,6 +351,7 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
         sampling::RandomWalkSampler sampler(task_proxy, *rng);
         vector<State> samples;
         vector<int> samples_h_values;
+        vector<vector<int>> samples_pdb_values;
 
         while (true) {
             ++num_iterations;
@@ -374,13 +373,24 @@ void PatternCollectionGeneratorHillclimbing::hill_climbing(
 
             samples.clear();
             samples_h_values.clear();
+            samples_pdb_values.clear();
             sample_states(sampler, init_h, samples);
+            const PDBCollection &pdbs = *current_pdbs->get_pattern_databases();
             for (const State &sample : samples) {
                 samples_h_values.push_back(current_pdbs->get_value(sample));
+                const vector<int> &sample_data = sample.get_unpacked_values();
+                vector<int> pdb_values;
+                pdb_values.reserve(pdbs.size());
+                for (const shared_ptr<PatternDatabase> &pdb : pdbs) {
+                    pdb_values.push_back(pdb->get_value(sample_data));
+                }
+                samples_pdb_values.push_back(move(pdb_values));
             }
 
             pair<int, int> improvement_and_index =
-                find_best_improving_pdb(samples, samples_h_values, candidate_pdbs);
+                find_best_improving_pdb(
+                    samples, samples_h_values, samples_pdb_values,
+                    candidate_pdbs);
             int improvement = improvement_and_index.first;
             int best_pdb_index = improvement_and_index.second;
 
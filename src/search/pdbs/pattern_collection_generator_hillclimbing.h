@@ -79,23 +79,29 @@ class PatternCollectionGeneratorHillclimbing : public PatternCollectionGenerator
       Searches for the best improving pdb in candidate_pdbs according to the
       counting approximation and the given samples. Returns the improvement and
       the index of the best pdb in candidate_pdbs.
+
+      The values of the current collection and of its PDBs for the samples
+      do not depend on the candidate, so they are computed once per
+      iteration and passed in as samples_h_values and samples_pdb_values.
     */
     std::pair<int, int> find_best_improving_pdb(
         const std::vector<State> &samples,
         const std::vector<int> &samples_h_values,
+        const std::vector<std::vector<int>> &samples_pdb_values,
         PDBCollection &candidate_pdbs);
 
     /*
       Returns true iff the h-value of the new pattern (from pdb) plus the
       h-value of all pattern cliques from the current pattern
       collection heuristic if the new pattern was added to it is greater than
-      the h-value of the current pattern collection.
+      the h-value of the current pattern collection. The h-values of the
+      PDBs in the current collection for the sample are given by pdb_values.
     */
     bool is_heuristic_improved(
         const PatternDatabase &pdb,
         const State &sample,
         int h_collection,
-        const PDBCollection &pdbs,
+        const std::vector<int> &pdb_values,
         const std::vector<PatternClique> &pattern_cliques);
 
     /*
@@ -21,6 +21,35 @@
 using namespace std;
 
 namespace pdbs {
+static const int INF = numeric_limits<int>::max();
+
+template<typename Entry>
+static void encode_distances(
+    const vector<int> &distances, vector<Entry> &entries) {
+    const Entry infinity = numeric_limits<Entry>::max();
+    entries.reserve(distances.size());
+    for (int distance : distances) {
+        entries.push_back(distance == INF ? infinity : distance);
+    }
+}
+
+DistanceTable::DistanceTable(vector<int> distances)
+    : num_entries(distances.size()) {
+    int max_finite_distance = 0;
+    for (int distance : distances) {
+        if (distance != INF) {
+            max_finite_distance = max(max_finite_distance, distance);
+        }
+    }
+    if (max_finite_distance < numeric_limits<uint8_t>::max()) {
+        encode_distances(distances, distances_8_bit);
+    } else if (max_finite_distance < numeric_limits<uint16_t>::max()) {
+        encode_distances(distances, distances_16_bit);
+    } else {
+        distances_32_bit = move(distances);
+    }
+}
+
 AbstractOperator::AbstractOperator(const vector<FactPair> &prev_pairs,
                                    const vector<FactPair> &pre_pairs,
                                    const vector<FactPair> &eff_pairs,
@@ -101,7 +130,14 @@ PatternDatabase::PatternDatabase(
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
     }
-    create_pdb(task_proxy, operator_costs, compute_plan, rng, compute_wildcard_plan);
+    /*
+      We only encode the distances after create_pdb returns, so that the
+      memory of its search data structures is released before the
+      distance table is allocated.
+    */
+    distances = DistanceTable(
+        create_pdb(task_proxy, operator_costs, compute_plan, rng,
+                   compute_wildcard_plan));
 }
 
 void PatternDatabase::multiply_out(
@@ -194,7 +230,7 @@ void PatternDatabase::build_abstract_operators(
                  variables, op.get_id(), operators);
 }
 
-void PatternDatabase::create_pdb(
+vector<int> PatternDatabase::create_pdb(
     const TaskProxy &task_proxy, const vector<int> &operator_costs,
     bool compute_plan, const shared_ptr<utils::RandomNumberGenerator> &rng,
     bool compute_wildcard_plan) {
@@ -234,7 +270,8 @@ void PatternDatabase::create_pdb(
         }
     }
 
-    distances.reserve(num_states);
+    vector<int> goal_distances;
+    goal_distances.reserve(num_states);
     // first implicit entry: priority, second entry: index for an abstract state
     priority_queues::AdaptiveQueue<int> pq;
 
@@ -242,9 +279,9 @@ void PatternDatabase::create_pdb(
     for (int state_index = 0; state_index < num_states; ++state_index) {
         if (is_goal_state(state_index, abstract_goals, variables)) {
             pq.push(0, state_index);
-            distances.push_back(0);
+            goal_distances.push_back(0);
         } else {
-            distances.push_back(numeric_limits<int>::max());
+            goal_distances.push_back(numeric_limits<int>::max());
         }
     }
 
@@ -267,7 +304,7 @@ void PatternDatabase::create_pdb(
         pair<int, int> node = pq.pop();
         int distance = node.first;
         int state_index = node.second;
-        if (distance > distances[state_index]) {
+        if (distance > goal_distances[state_index]) {
             continue;
         }
 
@@ -277,9 +314,9 @@ void PatternDatabase::create_pdb(
         for (int op_id : applicable_operator_ids) {
             const AbstractOperator &op = operators[op_id];
             int predecessor = state_index + op.get_hash_effect();
-            int alternative_cost = distances[state_index] + op.get_cost();
-            if (alternative_cost < distances[predecessor]) {
-                distances[predecessor] = alternative_cost;
+            int alternative_cost = goal_distances[state_index] + op.get_cost();
+            if (alternative_cost < goal_distances[predecessor]) {
+                goal_distances[predecessor] = alternative_cost;
                 pq.push(alternative_cost, predecessor);
                 if (compute_plan) {
                     generating_op_ids[predecessor] = op_id;
@@ -306,7 +343,7 @@ void PatternDatabase::create_pdb(
         initial_state.unpack();
         int current_state =
             hash_index(initial_state.get_unpacked_values());
-        if (distances[current_state] != numeric_limits<int>::max()) {
+        if (goal_distances[current_state] != numeric_limits<int>::max()) {
             while (!is_goal_state(current_state, abstract_goals, variables)) {
                 int op_id = generating_op_ids[current_state];
                 assert(op_id != -1);
@@ -338,6 +375,8 @@ void PatternDatabase::create_pdb(
         }
         utils::release_vector_memory(generating_op_ids);
     }
+
+    return goal_distances;
 }
 
 bool PatternDatabase::is_goal_state(
@@ -372,7 +411,7 @@ int PatternDatabase::get_value(const vector<int> &state) const {
 double PatternDatabase::compute_mean_finite_h() const {
     double sum = 0;
     int size = 0;
-    for (size_t i = 0; i < distances.size(); ++i) {
+    for (int i = 0; i < distances.size(); ++i) {
         if (distances[i] != numeric_limits<int>::max()) {
             sum += distances[i];
             ++size;
@@ -5,6 +5,8 @@
 
 #include "../task_proxy.h"
 
+#include <cstdint>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -81,6 +83,46 @@ public:
               utils::LogProxy &log) const;
 };
 
+/*
+  Goal distances of all abstract states of a PDB. Each distance is stored
+  in the smallest of 8, 16 or 32 bits that can represent all finite
+  distances of the PDB, so that typical PDBs with small distances need a
+  quarter of the memory of an int per abstract state. The largest value of
+  the chosen width encodes infinity.
+*/
+class DistanceTable {
+    int num_entries;
+    std::vector<std::uint8_t> distances_8_bit;
+    std::vector<std::uint16_t> distances_16_bit;
+    std::vector<int> distances_32_bit;
+
+    template<typename Entry>
+    static int decode(Entry entry) {
+        return entry == std::numeric_limits<Entry>::max() ?
+               std::numeric_limits<int>::max() : entry;
+    }
+public:
+    DistanceTable()
+        : num_entries(0) {
+    }
+
+    explicit DistanceTable(std::vector<int> distances);
+
+    int operator[](int index) const {
+        if (!distances_8_bit.empty()) {
+            return decode(distances_8_bit[index]);
+        } else if (!distances_16_bit.empty()) {
+            return decode(distances_16_bit[index]);
+        } else {
+            return distances_32_bit[index];
+        }
+    }
+
+    int size() const {
+        return num_entries;
+    }
+};
+
 // Implements a single pattern database
 class PatternDatabase {
     Pattern pattern;
@@ -92,7 +134,7 @@ class PatternDatabase {
       final h-values for abstract-states.
       dead-ends are represented by numeric_limits<int>::max()
     */
-    std::vector<int> distances;
+    DistanceTable distances;
 
     std::vector<int> generating_op_ids;
     std::vector<std::vector<OperatorID>> wildcard_plan;
@@ -132,11 +174,11 @@ class PatternDatabase {
     /*
       Computes all abstract operators, builds the match tree (successor
       generator) and then does a Dijkstra regression search to compute
-      all final h-values (stored in distances). operator_costs can
-      specify individual operator costs for each operator for action
-      cost partitioning. If left empty, default operator costs are used.
+      and return all final h-values. operator_costs can specify
+      individual operator costs for each operator for action cost
+      partitioning. If left empty, default operator costs are used.
     */
-    void create_pdb(
+    std::vector<int> create_pdb(
         const TaskProxy &task_proxy,
         const std::vector<int> &operator_costs,
         bool compute_plan,
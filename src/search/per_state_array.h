@@ -4,6 +4,7 @@
 #include "per_state_information.h"
 
 #include <cassert>
+#include <string>
 #include <unordered_map>
 
 
@@ -46,6 +47,7 @@ public:
 template<class Element>
 class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     const std::vector<Element> default_array;
+    const std::string name;
     using EntryArrayVectorMap = std::unordered_map<const StateRegistry *,
                                                    segmented_vector::SegmentedArrayVector<Element> *>;
     EntryArrayVectorMap entry_arrays_by_registry;
@@ -87,8 +89,11 @@ class PerStateArray : public subscriber::Subscriber<StateRegistry> {
     }
 
 public:
-    explicit PerStateArray(const std::vector<Element> &default_array)
+    explicit PerStateArray(
+        const std::vector<Element> &default_array,
+        const std::string &name = "unnamed")
         : default_array(default_array),
+          name(name),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
@@ -132,6 +137,17 @@ public:
         */
     }
 
+    virtual size_t estimate_memory_in_bytes(
+        const StateRegistry *registry) const override {
+        const segmented_vector::SegmentedArrayVector<Element> *entries =
+            get_entries(registry);
+        return entries ? entries->estimate_memory_in_bytes() : 0;
+    }
+
+    virtual std::string get_name() const override {
+        return name;
+    }
+
     virtual void notify_service_destroyed(const StateRegistry *registry) override {
         delete entry_arrays_by_registry[registry];
         entry_arrays_by_registry.erase(registry);
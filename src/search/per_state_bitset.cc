@@ -74,9 +74,10 @@ static vector<BitsetMath::Block> pack_bit_vector(const vector<bool> &bits) {
 }
 
 
-PerStateBitset::PerStateBitset(const vector<bool> &default_bits)
+PerStateBitset::PerStateBitset(
+    const vector<bool> &default_bits, const string &name)
     : num_bits_per_entry(default_bits.size()),
-      data(pack_bit_vector(default_bits)) {
+      data(pack_bit_vector(default_bits), name) {
 }
 
 BitsetView PerStateBitset::operator[](const State &state) {
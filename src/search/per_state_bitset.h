@@ -3,6 +3,7 @@
 
 #include "per_state_array.h"
 
+#include <string>
 #include <vector>
 
 
@@ -47,7 +48,9 @@ class PerStateBitset {
     int num_bits_per_entry;
     PerStateArray<BitsetMath::Block> data;
 public:
-    explicit PerStateBitset(const std::vector<bool> &default_bits);
+    explicit PerStateBitset(
+        const std::vector<bool> &default_bits,
+        const std::string &name = "unnamed");
 
     PerStateBitset(const PerStateBitset &) = delete;
     PerStateBitset &operator=(const PerStateBitset &) = delete;
@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <iostream>
+#include <string>
 #include <unordered_map>
 
 /*
@@ -39,6 +40,7 @@
 template<class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
     const Entry default_value;
+    const std::string name;
     using EntryVectorMap = std::unordered_map<const StateRegistry *,
                                               segmented_vector::SegmentedVector<Entry> * >;
     EntryVectorMap entries_by_registry;
@@ -91,12 +93,19 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
 public:
     PerStateInformation()
         : default_value(),
+          name("unnamed"),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
 
-    explicit PerStateInformation(const Entry &default_value_)
+    /*
+      The name identifies the stored information in memory reports
+      (see SearchTelemetry).
+    */
+    explicit PerStateInformation(
+        const Entry &default_value_, const std::string &name = "unnamed")
         : default_value(default_value_),
+          name(name),
           cached_registry(nullptr),
           cached_entries(nullptr) {
     }
@@ -149,6 +158,17 @@ public:
         return (*entries)[state_id];
     }
 
+    virtual size_t estimate_memory_in_bytes(
+        const StateRegistry *registry) const override {
+        const segmented_vector::SegmentedVector<Entry> *entries =
+            get_entries(registry);
+        return entries ? entries->estimate_memory_in_bytes() : 0;
+    }
+
+    virtual std::string get_name() const override {
+        return name;
+    }
+
     virtual void notify_service_destroyed(const StateRegistry *registry) override {
         delete entries_by_registry[registry];
         entries_by_registry.erase(registry);
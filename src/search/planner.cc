@@ -1,19 +1,42 @@
 #include "command_line.h"
 #include "option_parser.h"
 #include "search_engine.h"
+#include "search_statistics.h"
 
 #include "options/registries.h"
 #include "tasks/root_task.h"
 #include "task_utils/task_properties.h"
 #include "../utils/logging.h"
+#include "utils/profiling.h"
 #include "utils/system.h"
 #include "utils/timer.h"
 
 #include <iostream>
+#include <sstream>
 
 using namespace std;
 using utils::ExitCode;
 
+#ifdef USE_PROFILING
+static void print_profile(
+    const SearchStatistics &statistics, const utils::Timer &search_timer) {
+    ostringstream json;
+    json << "{\"expanded\": " << statistics.get_expanded()
+         << ", \"evaluated\": " << statistics.get_evaluated_states()
+         << ", \"evaluations\": " << statistics.get_evaluations()
+         << ", \"generated\": " << statistics.get_generated()
+         << ", \"reopened\": " << statistics.get_reopened()
+         << ", \"generated_ops\": " << statistics.get_generated_ops()
+         << ", \"search_time\": " << static_cast<double>(search_timer())
+         << ", \"total_time\": " << static_cast<double>(utils::g_timer())
+         << ", \"peak_memory\": " << utils::get_peak_memory_in_kb()
+         << ", \"components\": ";
+    utils::dump_profile_json(json);
+    json << "}";
+    utils::g_log << "Profile: " << json.str() << endl;
+}
+#endif
+
 int main(int argc, const char **argv) {
     utils::register_event_handlers();
 
@@ -61,6 +84,9 @@ int main(int argc, const char **argv) {
     engine->print_statistics();
     utils::g_log << "Search time: " << search_timer << endl;
     utils::g_log << "Total time: " << utils::g_timer << endl;
+#ifdef USE_PROFILING
+    print_profile(engine->get_statistics(), search_timer);
+#endif
 
     ExitCode exitcode = engine->found_solution()
         ? ExitCode::SUCCESS
@@ -7,6 +7,20 @@
 using namespace std;
 
 namespace stubborn_sets {
+vector<int> get_operators(const OperatorBitset &ops) {
+    vector<int> op_nos;
+    int num_blocks = ops.size();
+    for (int block = 0; block < num_blocks; ++block) {
+        uint64_t block_ops = ops[block];
+        for (int op_no = block * BITS_PER_BLOCK; block_ops; ++op_no, block_ops >>= 1) {
+            if (block_ops & 1) {
+                op_nos.push_back(op_no);
+            }
+        }
+    }
+    return op_nos;
+}
+
 StubbornSets::StubbornSets(const Options &opts)
     : PruningMethod(opts),
       num_operators(-1) {
@@ -60,7 +74,7 @@ void StubbornSets::compute_achievers(const TaskProxy &task_proxy) {
 
 void StubbornSets::prune(const State &state, vector<OperatorID> &op_ids) {
     // Clear stubborn set from previous call.
-    stubborn.assign(num_operators, false);
+    stubborn.assign(get_num_blocks(num_operators), 0);
 
     compute_stubborn_set(state);
 
@@ -68,7 +82,7 @@ void StubbornSets::prune(const State &state, vector<OperatorID> &op_ids) {
     vector<OperatorID> remaining_op_ids;
     remaining_op_ids.reserve(op_ids.size());
     for (OperatorID op_id : op_ids) {
-        if (stubborn[op_id.get_index()]) {
+        if (is_stubborn(op_id.get_index())) {
             remaining_op_ids.emplace_back(op_id);
         }
     }
@@ -5,10 +5,40 @@
 
 #include "../task_proxy.h"
 
+#include <cstdint>
+
 namespace stubborn_sets {
 inline FactPair find_unsatisfied_condition(
     const std::vector<FactPair> &conditions, const State &state);
 
+/*
+  A set of operators, stored as a bitset over operator indices. Bit
+  op_no % BITS_PER_BLOCK of block op_no / BITS_PER_BLOCK is set iff the
+  set contains the operator with index op_no. Storing whole blocks allows
+  adding many operators to a set with a few word operations.
+*/
+using OperatorBitset = std::vector<std::uint64_t>;
+const int BITS_PER_BLOCK = 64;
+
+inline int get_num_blocks(int num_operators) {
+    return (num_operators + BITS_PER_BLOCK - 1) / BITS_PER_BLOCK;
+}
+
+inline bool contains_operator(const OperatorBitset &ops, int op_no) {
+    return (ops[op_no / BITS_PER_BLOCK] >> (op_no % BITS_PER_BLOCK)) & 1;
+}
+
+inline void add_operator(OperatorBitset &ops, int op_no) {
+    ops[op_no / BITS_PER_BLOCK] |= std::uint64_t(1) << (op_no % BITS_PER_BLOCK);
+}
+
+inline void remove_operator(OperatorBitset &ops, int op_no) {
+    ops[op_no / BITS_PER_BLOCK] &= ~(std::uint64_t(1) << (op_no % BITS_PER_BLOCK));
+}
+
+// Return the operator indices of the set in increasing order.
+extern std::vector<int> get_operators(const OperatorBitset &ops);
+
 class StubbornSets : public PruningMethod {
     void compute_sorted_operators(const TaskProxy &task_proxy);
     void compute_achievers(const TaskProxy &task_proxy);
@@ -28,9 +58,12 @@ protected:
        operators that achieve the fact (var, value). */
     std::vector<std::vector<std::vector<int>>> achievers;
 
-    /* stubborn[op_no] is true iff the operator with operator index
-       op_no is contained in the stubborn set */
-    std::vector<bool> stubborn;
+    // The operators contained in the stubborn set.
+    OperatorBitset stubborn;
+
+    bool is_stubborn(int op_no) const {
+        return contains_operator(stubborn, op_no);
+    }
 
     /*
       Return the first unsatified precondition,
@@ -1,32 +1,50 @@
 #include "stubborn_sets_action_centric.h"
 
+#include "../utils/collections.h"
+
 using namespace std;
 
 namespace stubborn_sets {
-// Relies on both fact sets being sorted by variable.
-static bool contain_conflicting_fact(const vector<FactPair> &facts1,
-                                     const vector<FactPair> &facts2) {
-    auto facts1_it = facts1.begin();
-    auto facts2_it = facts2.begin();
-    while (facts1_it != facts1.end() && facts2_it != facts2.end()) {
-        if (facts1_it->var < facts2_it->var) {
-            ++facts1_it;
-        } else if (facts1_it->var > facts2_it->var) {
-            ++facts2_it;
-        } else {
-            if (facts1_it->value != facts2_it->value)
-                return true;
-            ++facts1_it;
-            ++facts2_it;
+/*
+  Add all operators of ops_by_value[value] for all values other than
+  fact.value, i.e., the operators that contradict the fact.
+*/
+static void add_operators_with_other_value(
+    const FactPair &fact, const vector<vector<int>> &ops_by_value,
+    OperatorBitset &ops) {
+    int num_values = ops_by_value.size();
+    for (int value = 0; value < num_values; ++value) {
+        if (value != fact.value) {
+            for (int op_no : ops_by_value[value]) {
+                add_operator(ops, op_no);
+            }
         }
     }
-    return false;
 }
 
 StubbornSetsActionCentric::StubbornSetsActionCentric(const options::Options &opts)
     : StubbornSets(opts) {
 }
 
+void StubbornSetsActionCentric::initialize(const shared_ptr<AbstractTask> &task) {
+    StubbornSets::initialize(task);
+    compute_ops_by_precondition(TaskProxy(*task));
+}
+
+void StubbornSetsActionCentric::compute_ops_by_precondition(
+    const TaskProxy &task_proxy) {
+    ops_by_precondition = utils::map_vector<vector<vector<int>>>(
+        task_proxy.get_variables(), [](const VariableProxy &var) {
+            return vector<vector<int>>(var.get_domain_size());
+        });
+
+    for (int op_no = 0; op_no < num_operators; ++op_no) {
+        for (const FactPair &pre : sorted_op_preconditions[op_no]) {
+            ops_by_precondition[pre.var][pre.value].push_back(op_no);
+        }
+    }
+}
+
 void StubbornSetsActionCentric::compute_stubborn_set(const State &state) {
     assert(stubborn_queue.empty());
 
@@ -40,24 +58,49 @@ void StubbornSetsActionCentric::compute_stubborn_set(const State &state) {
     }
 }
 
-// Relies on op_preconds and op_effects being sorted by variable.
-bool StubbornSetsActionCentric::can_disable(int op1_no, int op2_no) const {
-    return contain_conflicting_fact(sorted_op_effects[op1_no],
-                                    sorted_op_preconditions[op2_no]);
+void StubbornSetsActionCentric::add_disabled_operators(
+    int op_no, OperatorBitset &ops) const {
+    for (const FactPair &effect : sorted_op_effects[op_no]) {
+        add_operators_with_other_value(
+            effect, ops_by_precondition[effect.var], ops);
+    }
 }
 
-// Relies on op_effect being sorted by variable.
-bool StubbornSetsActionCentric::can_conflict(int op1_no, int op2_no) const {
-    return contain_conflicting_fact(sorted_op_effects[op1_no],
-                                    sorted_op_effects[op2_no]);
+void StubbornSetsActionCentric::add_conflicting_operators(
+    int op_no, OperatorBitset &ops) const {
+    for (const FactPair &effect : sorted_op_effects[op_no]) {
+        add_operators_with_other_value(effect, achievers[effect.var], ops);
+    }
+}
+
+void StubbornSetsActionCentric::add_disabling_operators(
+    int op_no, OperatorBitset &ops) const {
+    for (const FactPair &pre : sorted_op_preconditions[op_no]) {
+        add_operators_with_other_value(pre, achievers[pre.var], ops);
+    }
 }
 
 bool StubbornSetsActionCentric::enqueue_stubborn_operator(int op_no) {
-    if (!stubborn[op_no]) {
-        stubborn[op_no] = true;
+    if (!is_stubborn(op_no)) {
+        add_operator(stubborn, op_no);
         stubborn_queue.push_back(op_no);
         return true;
     }
     return false;
 }
+
+void StubbornSetsActionCentric::enqueue_stubborn_operators(
+    const OperatorBitset &ops) {
+    assert(ops.size() == stubborn.size());
+    int num_blocks = ops.size();
+    for (int block = 0; block < num_blocks; ++block) {
+        uint64_t new_ops = ops[block] & ~stubborn[block];
+        stubborn[block] |= new_ops;
+        for (int op_no = block * BITS_PER_BLOCK; new_ops; ++op_no, new_ops >>= 1) {
+            if (new_ops & 1) {
+                stubborn_queue.push_back(op_no);
+            }
+        }
+    }
+}
 }
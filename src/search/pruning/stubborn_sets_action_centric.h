@@ -13,13 +13,28 @@ class StubbornSetsActionCentric : public stubborn_sets::StubbornSets {
     */
     std::vector<int> stubborn_queue;
 
+    /* ops_by_precondition[var][value] contains all operator indices of
+       operators with precondition (var, value). */
+    std::vector<std::vector<std::vector<int>>> ops_by_precondition;
+
+    void compute_ops_by_precondition(const TaskProxy &task_proxy);
+
     virtual void initialize_stubborn_set(const State &state) = 0;
     virtual void handle_stubborn_operator(const State &state, int op_no) = 0;
     virtual void compute_stubborn_set(const State &state) override;
 protected:
     explicit StubbornSetsActionCentric(const options::Options &opts);
-    bool can_disable(int op1_no, int op2_no) const;
-    bool can_conflict(int op1_no, int op2_no) const;
+
+    /*
+      Add all operators that op can disable, that can conflict with op, and
+      that can disable op, respectively. Instead of testing all operators,
+      these functions only look at the operators with a precondition or
+      effect that contradicts a fact of op. The result may contain op
+      itself.
+    */
+    void add_disabled_operators(int op_no, OperatorBitset &ops) const;
+    void add_conflicting_operators(int op_no, OperatorBitset &ops) const;
+    void add_disabling_operators(int op_no, OperatorBitset &ops) const;
 
     /*
       Return the first unsatified goal pair,
@@ -34,6 +49,10 @@ protected:
 
     // Return true iff the operator was enqueued.
     bool enqueue_stubborn_operator(int op_no);
+    // Enqueue all operators of the set that are not yet stubborn.
+    void enqueue_stubborn_operators(const OperatorBitset &ops);
+public:
+    virtual void initialize(const std::shared_ptr<AbstractTask> &task) override;
 };
 }
 
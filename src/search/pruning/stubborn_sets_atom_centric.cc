@@ -160,7 +160,7 @@ FactPair StubbornSetsAtomCentric::select_fact(
             if (state[condition.var].get_value() != condition.value) {
                 const vector<int> &ops = achievers[condition.var][condition.value];
                 int count = count_if(
-                    ops.begin(), ops.end(), [&](int op) {return !stubborn[op];});
+                    ops.begin(), ops.end(), [&](int op) {return !is_stubborn(op);});
                 if (count < min_count) {
                     fact = condition;
                     min_count = count;
@@ -231,8 +231,8 @@ void StubbornSetsAtomCentric::compute_stubborn_set(const State &state) {
 }
 
 void StubbornSetsAtomCentric::handle_stubborn_operator(const State &state, int op) {
-    if (!stubborn[op]) {
-        stubborn[op] = true;
+    if (!is_stubborn(op)) {
+        stubborn_sets::add_operator(stubborn, op);
         if (operator_is_applicable(op, state)) {
             enqueue_interferers(op);
         } else {
@@ -108,7 +108,7 @@ StubbornSetsEC::StubbornSetsEC(const options::Options &opts)
 }
 
 void StubbornSetsEC::initialize(const shared_ptr<AbstractTask> &task) {
-    StubbornSets::initialize(task);
+    StubbornSetsActionCentric::initialize(task);
     TaskProxy task_proxy(*task);
     VariablesProxy variables = task_proxy.get_variables();
     written_vars.assign(variables.size(), false);
@@ -183,16 +183,12 @@ void StubbornSetsEC::compute_active_operators(const State &state) {
 const vector<int> &StubbornSetsEC::get_conflicting_and_disabling(int op1_no) {
     vector<int> &result = conflicting_and_disabling[op1_no];
     if (!conflicting_and_disabling_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no) {
-                bool conflict = can_conflict(op1_no, op2_no);
-                bool disable = can_disable(op2_no, op1_no);
-                if (conflict || disable) {
-                    result.push_back(op2_no);
-                }
-            }
-        }
-        result.shrink_to_fit();
+        stubborn_sets::OperatorBitset ops(
+            stubborn_sets::get_num_blocks(num_operators), 0);
+        add_conflicting_operators(op1_no, ops);
+        add_disabling_operators(op1_no, ops);
+        stubborn_sets::remove_operator(ops, op1_no);
+        result = stubborn_sets::get_operators(ops);
         conflicting_and_disabling_computed[op1_no] = true;
     }
     return result;
@@ -201,12 +197,11 @@ const vector<int> &StubbornSetsEC::get_conflicting_and_disabling(int op1_no) {
 const vector<int> &StubbornSetsEC::get_disabled(int op1_no) {
     vector<int> &result = disabled[op1_no];
     if (!disabled_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op2_no != op1_no && can_disable(op1_no, op2_no)) {
-                result.push_back(op2_no);
-            }
-        }
-        result.shrink_to_fit();
+        stubborn_sets::OperatorBitset ops(
+            stubborn_sets::get_num_blocks(num_operators), 0);
+        add_disabled_operators(op1_no, ops);
+        stubborn_sets::remove_operator(ops, op1_no);
+        result = stubborn_sets::get_operators(ops);
         disabled_computed[op1_no] = true;
     }
     return result;
@@ -13,29 +13,29 @@ StubbornSetsSimple::StubbornSetsSimple(const options::Options &opts)
 }
 
 void StubbornSetsSimple::initialize(const shared_ptr<AbstractTask> &task) {
-    StubbornSets::initialize(task);
+    StubbornSetsActionCentric::initialize(task);
     interference_relation.resize(num_operators);
+    interference_bitsets.resize(num_operators);
     interference_relation_computed.resize(num_operators, false);
     log << "pruning method: stubborn sets simple" << endl;
 }
 
-const vector<int> &StubbornSetsSimple::get_interfering_operators(int op1_no) {
-    /*
-       TODO: as interference is symmetric, we only need to compute the
-       relation for operators (o1, o2) with (o1 < o2) and add a lookup
-       method that looks up (i, j) if i < j and (j, i) otherwise.
-    */
-    vector<int> &interfere_op1 = interference_relation[op1_no];
-    if (!interference_relation_computed[op1_no]) {
-        for (int op2_no = 0; op2_no < num_operators; ++op2_no) {
-            if (op1_no != op2_no && interfere(op1_no, op2_no)) {
-                interfere_op1.push_back(op2_no);
-            }
-        }
-        interfere_op1.shrink_to_fit();
-        interference_relation_computed[op1_no] = true;
+void StubbornSetsSimple::compute_interfering_operators(int op1_no) {
+    stubborn_sets::OperatorBitset interferers(
+        stubborn_sets::get_num_blocks(num_operators), 0);
+    add_disabled_operators(op1_no, interferers);
+    add_conflicting_operators(op1_no, interferers);
+    add_disabling_operators(op1_no, interferers);
+    stubborn_sets::remove_operator(interferers, op1_no);
+
+    vector<int> interferer_nos = stubborn_sets::get_operators(interferers);
+    if (interferer_nos.size() * sizeof(int) <
+        interferers.size() * sizeof(uint64_t)) {
+        interference_relation[op1_no] = move(interferer_nos);
+    } else {
+        interference_bitsets[op1_no] = move(interferers);
     }
-    return interfere_op1;
+    interference_relation_computed[op1_no] = true;
 }
 
 // Add all operators that achieve the fact (var, value) to stubborn set.
@@ -47,8 +47,16 @@ void StubbornSetsSimple::add_necessary_enabling_set(const FactPair &fact) {
 
 // Add all operators that interfere with op.
 void StubbornSetsSimple::add_interfering(int op_no) {
-    for (int interferer_no : get_interfering_operators(op_no)) {
-        enqueue_stubborn_operator(interferer_no);
+    if (!interference_relation_computed[op_no]) {
+        compute_interfering_operators(op_no);
+    }
+    const stubborn_sets::OperatorBitset &interferers = interference_bitsets[op_no];
+    if (interferers.empty()) {
+        for (int interferer_no : interference_relation[op_no]) {
+            enqueue_stubborn_operator(interferer_no);
+        }
+    } else {
+        enqueue_stubborn_operators(interferers);
     }
 }
 
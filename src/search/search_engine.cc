@@ -4,12 +4,14 @@
 #include "evaluator.h"
 #include "option_parser.h"
 #include "plugin.h"
+#include "search_telemetry.h"
 
 #include "algorithms/ordered_set.h"
 #include "task_utils/successor_generator.h"
 #include "task_utils/task_properties.h"
 #include "tasks/root_task.h"
 #include "utils/countdown_timer.h"
+#include "utils/memory.h"
 #include "utils/rng_options.h"
 #include "utils/system.h"
 #include "utils/timer.h"
@@ -23,6 +25,23 @@ using utils::ExitCode;
 
 class PruningMethod;
 
+namespace options {
+template<>
+struct TypeNamer<shared_ptr<StateRegistry>> {
+    static string name(const Registry &) {
+        return "StateRegistry";
+    }
+};
+}
+
+static shared_ptr<StateRegistry> get_state_registry(
+    const Options &opts, const TaskProxy &task_proxy) {
+    if (opts.contains("state_registry")) {
+        return opts.get<shared_ptr<StateRegistry>>("state_registry");
+    }
+    return make_shared<StateRegistry>(task_proxy);
+}
+
 successor_generator::SuccessorGenerator &get_successor_generator(
     const TaskProxy &task_proxy, utils::LogProxy &log) {
     log << "Building successor generator..." << flush;
@@ -47,7 +66,8 @@ SearchEngine::SearchEngine(const Options &opts)
       task(tasks::g_root_task),
       task_proxy(*task),
       log(utils::get_log_from_options(opts)),
-      state_registry(task_proxy),
+      state_registry_ptr(get_state_registry(opts, task_proxy)),
+      state_registry(*state_registry_ptr),
       successor_generator(get_successor_generator(task_proxy, log)),
       search_space(state_registry, log),
       statistics(log),
@@ -59,6 +79,12 @@ SearchEngine::SearchEngine(const Options &opts)
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
     bound = opts.get<int>("bound");
+    if (opts.contains("telemetry_file")) {
+        telemetry = utils::make_unique_ptr<SearchTelemetry>(
+            opts.get<string>("telemetry_file"),
+            opts.get<double>("telemetry_interval"),
+            statistics, search_progress, state_registry);
+    }
     task_properties::print_variable_statistics(task_proxy);
 }
 
@@ -88,12 +114,21 @@ void SearchEngine::search() {
     utils::CountdownTimer timer(max_time);
     while (status == IN_PROGRESS) {
         status = step();
+        if (telemetry) {
+            double search_time = timer.get_elapsed_time();
+            if (telemetry->is_record_due(search_time)) {
+                telemetry->write_record(search_time, get_open_list_size());
+            }
+        }
         if (timer.is_expired()) {
             log << "Time limit reached. Abort search." << endl;
             status = TIMEOUT;
             break;
         }
     }
+    if (telemetry) {
+        telemetry->write_record(timer.get_elapsed_time(), get_open_list_size());
+    }
     // TODO: Revise when and which search times are logged.
     log << "Actual search time: " << timer.get_elapsed_time() << endl;
 }
@@ -148,6 +183,31 @@ void SearchEngine::add_options_to_parser(OptionParser &parser) {
         "experiments. Timed-out searches are treated as failed searches, "
         "just like incomplete search algorithms that exhaust their search space.",
         "infinity");
+    parser.add_option<string>(
+        "telemetry_file",
+        "file to which the search periodically appends a JSON record of its "
+        "progress and memory usage. The file can be a named pipe read by a "
+        "process that monitors the search. If omitted, no records are written.",
+        OptionParser::NONE);
+    parser.add_option<double>(
+        "telemetry_interval",
+        "search time in seconds between two telemetry records. A final record "
+        "is written when the search ends.",
+        "10",
+        Bounds("0.0", "infinity"));
+    /*
+      Search engines that run other search engines on the same task
+      (iterated and portfolio search) set this option internally to share
+      states and per-state information between them. It cannot be set on
+      the command line, so we do not document it for each search engine.
+    */
+    if (!parser.help_mode()) {
+        parser.add_option<shared_ptr<StateRegistry>>(
+            "state_registry",
+            "registry in which the search registers its states. If omitted, "
+            "the search creates its own registry.",
+            OptionParser::NONE);
+    }
     utils::add_log_options_to_parser(parser);
 }
 
@@ -12,6 +12,7 @@
 
 #include "utils/logging.h"
 
+#include <memory>
 #include <vector>
 
 namespace options {
@@ -28,6 +29,8 @@ namespace successor_generator {
 class SuccessorGenerator;
 }
 
+class SearchTelemetry;
+
 enum SearchStatus {IN_PROGRESS, TIMEOUT, FAILED, SOLVED};
 
 class SearchEngine {
@@ -42,7 +45,12 @@ protected:
 
     mutable utils::LogProxy log;
     PlanManager plan_manager;
-    StateRegistry state_registry;
+    /*
+      Each search engine registers its states in a registry of its own
+      unless a registry is passed with the state_registry option.
+    */
+    std::shared_ptr<StateRegistry> state_registry_ptr;
+    StateRegistry &state_registry;
     const successor_generator::SuccessorGenerator &successor_generator;
     SearchSpace search_space;
     SearchProgress search_progress;
@@ -51,9 +59,12 @@ protected:
     OperatorCost cost_type;
     bool is_unit_cost;
     double max_time;
+    std::unique_ptr<SearchTelemetry> telemetry;
 
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
+    // Return the number of open list entries or -1 if there is no open list.
+    virtual int get_open_list_size() const {return -1;}
 
     void set_plan(const Plan &plan);
     bool check_goal_and_set_plan(const State &state);
@@ -70,6 +81,8 @@ public:
     const SearchStatistics &get_statistics() const {return statistics;}
     void set_bound(int b) {bound = b;}
     int get_bound() {return bound;}
+    double get_max_time() const {return max_time;}
+    void set_max_time(double time) {max_time = time;}
     PlanManager &get_plan_manager() {return plan_manager;}
 
     /* The following three methods should become functions as they
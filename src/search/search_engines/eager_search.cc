@@ -108,6 +108,10 @@ void EagerSearch::print_statistics() const {
     pruning_method->print_statistics();
 }
 
+int EagerSearch::get_open_list_size() const {
+    return open_list->get_num_entries();
+}
+
 SearchStatus EagerSearch::step() {
     tl::optional<SearchNode> node;
     while (true) {
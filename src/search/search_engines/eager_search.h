@@ -35,6 +35,7 @@ class EagerSearch : public SearchEngine {
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual int get_open_list_size() const override;
 
 public:
     explicit EagerSearch(const options::Options &opts);
@@ -273,6 +273,10 @@ void EnforcedHillClimbingSearch::print_statistics() const {
     }
 }
 
+int EnforcedHillClimbingSearch::get_open_list_size() const {
+    return open_list->get_num_entries();
+}
+
 static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.document_synopsis("Lazy enforced hill-climbing", "");
     parser.add_option<shared_ptr<Evaluator>>("h", "heuristic");
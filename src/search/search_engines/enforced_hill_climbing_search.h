@@ -58,6 +58,7 @@ class EnforcedHillClimbingSearch : public SearchEngine {
 protected:
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual int get_open_list_size() const override;
 
 public:
     explicit EnforcedHillClimbingSearch(const options::Options &opts);
@@ -14,8 +14,8 @@ IteratedSearch::IteratedSearch(const Options &opts, options::Registry &registry,
                                const options::Predefinitions &predefinitions)
     : SearchEngine(opts),
       engine_configs(opts.get_list<ParseTree>("engine_configs")),
-      registry(registry),
-      predefinitions(predefinitions),
+      engine_factory(registry, predefinitions, task_proxy,
+                     opts.get<bool>("warm_start")),
       pass_bound(opts.get<bool>("pass_bound")),
       repeat_last_phase(opts.get<bool>("repeat_last")),
       continue_on_fail(opts.get<bool>("continue_on_fail")),
@@ -28,8 +28,8 @@ IteratedSearch::IteratedSearch(const Options &opts, options::Registry &registry,
 
 shared_ptr<SearchEngine> IteratedSearch::get_search_engine(
     int engine_configs_index) {
-    OptionParser parser(engine_configs[engine_configs_index], registry, predefinitions, false);
-    shared_ptr<SearchEngine> engine(parser.start_parsing<shared_ptr<SearchEngine>>());
+    shared_ptr<SearchEngine> engine = engine_factory.create_search_engine(
+        engine_configs[engine_configs_index]);
 
     ostringstream stream;
     kptree::print_tree_bracketed(engine_configs[engine_configs_index], stream);
@@ -133,9 +133,10 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.document_synopsis("Iterated search", "");
     parser.document_note(
         "Note 1",
-        "We don't cache heuristic values between search iterations at"
-        " the moment. If you perform a LAMA-style iterative search,"
-        " heuristic values will be computed multiple times.");
+        "By default, we don't cache heuristic values between search "
+        "iterations. If you perform a LAMA-style iterative search, "
+        "heuristic values will be computed multiple times unless you use "
+        "the warm_start option.");
     parser.document_note(
         "Note 2",
         "The configuration\n```\n"
@@ -172,6 +173,13 @@ static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
     parser.add_option<bool>("continue_on_solve",
                             "continue search after solution found",
                             "true");
+    parser.add_option<bool>(
+        "warm_start",
+        "let all phases use the same state registry and the same evaluator "
+        "objects for identical evaluator configurations. Evaluators that "
+        "cache their values then reuse the values of all states seen in "
+        "earlier phases.",
+        "false");
     SearchEngine::add_options_to_parser(parser);
     Options opts = parser.parse();
 
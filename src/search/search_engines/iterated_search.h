@@ -1,12 +1,11 @@
 #ifndef SEARCH_ENGINES_ITERATED_SEARCH_H
 #define SEARCH_ENGINES_ITERATED_SEARCH_H
 
+#include "search_engine_factory.h"
+
 #include "../option_parser_util.h"
 #include "../search_engine.h"
 
-#include "../options/registries.h"
-#include "../options/predefinitions.h"
-
 namespace options {
 class Options;
 }
@@ -14,12 +13,7 @@ class Options;
 namespace iterated_search {
 class IteratedSearch : public SearchEngine {
     const std::vector<options::ParseTree> engine_configs;
-    /*
-      We need to copy the registry and predefinitions here since they live
-      longer than the objects referenced in the constructor.
-    */
-    options::Registry registry;
-    options::Predefinitions predefinitions;
+    search_engine_factory::SearchEngineFactory engine_factory;
     bool pass_bound;
     bool repeat_last_phase;
     bool continue_on_fail;
@@ -216,4 +216,8 @@ void LazySearch::print_statistics() const {
     statistics.print_detailed_statistics();
     search_space.print_statistics();
 }
+
+int LazySearch::get_open_list_size() const {
+    return open_list->get_num_entries();
+}
 }
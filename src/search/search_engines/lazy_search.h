@@ -41,6 +41,7 @@ protected:
 
     virtual void initialize() override;
     virtual SearchStatus step() override;
+    virtual int get_open_list_size() const override;
 
     void generate_successors();
     SearchStatus fetch_next_state();
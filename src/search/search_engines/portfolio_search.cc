@@ -0,0 +1,224 @@
+#include "portfolio_search.h"
+
+#include "../option_parser.h"
+#include "../plugin.h"
+
+#include "../utils/countdown_timer.h"
+#include "../utils/logging.h"
+#include "../utils/memory.h"
+
+#include <algorithm>
+#include <iostream>
+#include <numeric>
+
+using namespace std;
+
+namespace portfolio_search {
+PortfolioSearch::PortfolioSearch(
+    const Options &opts, options::Registry &registry,
+    const options::Predefinitions &predefinitions)
+    : SearchEngine(opts),
+      engine_configs(opts.get_list<ParseTree>("engine_configs")),
+      relative_times(opts.get_list<int>("relative_times")),
+      engine_factory(registry, predefinitions, task_proxy,
+                     opts.get<bool>("warm_start")),
+      optimal(opts.get<bool>("optimal")),
+      round_position(0),
+      best_bound(bound) {
+    if (relative_times.empty()) {
+        relative_times.assign(engine_configs.size(), 1);
+    }
+    current_round.resize(engine_configs.size());
+    iota(current_round.begin(), current_round.end(), 0);
+}
+
+PortfolioSearch::~PortfolioSearch() {
+}
+
+void PortfolioSearch::initialize() {
+    portfolio_timer = utils::make_unique_ptr<utils::CountdownTimer>(max_time);
+}
+
+shared_ptr<SearchEngine> PortfolioSearch::create_component(int component) {
+    shared_ptr<SearchEngine> engine =
+        engine_factory.create_search_engine(engine_configs[component]);
+
+    ostringstream stream;
+    kptree::print_tree_bracketed(engine_configs[component], stream);
+    log << "Starting portfolio component: " << stream.str() << endl;
+
+    return engine;
+}
+
+double PortfolioSearch::compute_time_slice() const {
+    /* Like the portfolio runner of the driver, we distribute the remaining
+       time among the remaining components of the round. */
+    int remaining_relative_time = 0;
+    for (size_t i = round_position; i < current_round.size(); ++i) {
+        remaining_relative_time += relative_times[current_round[i]];
+    }
+    int relative_time = relative_times[current_round[round_position]];
+    return portfolio_timer->get_remaining_time() * relative_time /
+           remaining_relative_time;
+}
+
+SearchStatus PortfolioSearch::step() {
+    if (round_position == static_cast<int>(current_round.size())) {
+        if (next_round.empty()) {
+            return found_solution() ? SOLVED : FAILED;
+        }
+        log << "Starting next portfolio round with the components that "
+            << "found a plan." << endl;
+        current_round.swap(next_round);
+        next_round.clear();
+        round_position = 0;
+    }
+
+    double time_slice = compute_time_slice();
+    if (time_slice <= 0) {
+        return found_solution() ? SOLVED : TIMEOUT;
+    }
+    log << "Time slice for portfolio component: " << time_slice << "s" << endl;
+    int component = current_round[round_position];
+    ++round_position;
+
+    /* The construction of the component, which includes the computation of
+       its heuristics, counts against the time slice. It cannot be
+       interrupted, so the slice is a soft limit (see documentation). */
+    utils::CountdownTimer component_timer(time_slice);
+    shared_ptr<SearchEngine> current_search = create_component(component);
+    current_search->set_bound(best_bound);
+    current_search->set_max_time(
+        min(current_search->get_max_time(),
+            static_cast<double>(component_timer.get_remaining_time())));
+    current_search->search();
+
+    if (current_search->found_solution()) {
+        const Plan &found_plan = current_search->get_plan();
+        int plan_cost = calculate_plan_cost(found_plan, task_proxy);
+        if (plan_cost < best_bound) {
+            if (!optimal) {
+                plan_manager.save_plan(found_plan, task_proxy, true);
+            }
+            best_bound = plan_cost;
+            set_plan(found_plan);
+        }
+        next_round.push_back(component);
+    }
+    current_search->print_statistics();
+
+    const SearchStatistics &current_stats = current_search->get_statistics();
+    statistics.inc_expanded(current_stats.get_expanded());
+    statistics.inc_evaluated_states(current_stats.get_evaluated_states());
+    statistics.inc_evaluations(current_stats.get_evaluations());
+    statistics.inc_generated(current_stats.get_generated());
+    statistics.inc_generated_ops(current_stats.get_generated_ops());
+    statistics.inc_reopened(current_stats.get_reopened());
+
+    if (found_solution()) {
+        log << "Best solution cost so far: " << best_bound << endl;
+        if (optimal) {
+            return SOLVED;
+        }
+    }
+    return IN_PROGRESS;
+}
+
+void PortfolioSearch::print_statistics() const {
+    log << "Cumulative statistics:" << endl;
+    statistics.print_detailed_statistics();
+}
+
+void PortfolioSearch::save_plan_if_necessary() {
+    /* Satisficing portfolios save each improving plan as soon as it is
+       found. Optimal portfolios stop after the first plan. */
+    if (optimal) {
+        SearchEngine::save_plan_if_necessary();
+    }
+}
+
+static shared_ptr<SearchEngine> _parse(OptionParser &parser) {
+    parser.document_synopsis(
+        "Portfolio search",
+        "Runs the given search engines one after the other in the same "
+        "process, each in its own time slice. Like the portfolios of the "
+        "driver, each component receives the remaining time multiplied by "
+        "its share of the relative times of the remaining components, and "
+        "satisficing portfolios repeat the components that found a plan "
+        "with the cost of the best plan as bound. "
+        "Since all components run in one process, they share the task "
+        "and all data computed for it, such as the successor generator and "
+        "the causal graph.");
+    parser.document_note(
+        "Sharing heuristics",
+        "Use heuristic predefinition to share evaluators between "
+        "components, for example\n```\n"
+        "--evaluator \"h=lmcut()\" --search "
+        "\"portfolio([astar(h), eager_greedy([h])], optimal=false)\"\n"
+        "```\n"
+        "With the warm_start option, this happens automatically for "
+        "evaluators with identical configurations.");
+    parser.document_note(
+        "Time limits",
+        "The overall time limit is given by the max_time option. The "
+        "construction of a component counts against its time slice, but "
+        "only the search itself is interrupted when the slice is used up. "
+        "Time slices are therefore soft: if computing the heuristics of a "
+        "component takes longer than its slice, its search stops after the "
+        "first step and the excess time is taken from the remaining "
+        "components.");
+    parser.add_list_option<ParseTree>(
+        "engine_configs", "search engines of the portfolio components");
+    parser.add_list_option<int>(
+        "relative_times",
+        "relative time of each component. If empty, all components "
+        "get the same relative time.",
+        "[]");
+    parser.add_option<bool>(
+        "optimal",
+        "stop after the first plan is found instead of searching for "
+        "cheaper plans",
+        "true");
+    parser.add_option<bool>(
+        "warm_start",
+        "let all components use the same state registry and the same "
+        "evaluator objects for identical evaluator configurations. "
+        "Evaluators that cache their values then reuse the values of all "
+        "states seen by earlier components.",
+        "false");
+    SearchEngine::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    opts.verify_list_non_empty<ParseTree>("engine_configs");
+
+    if (!parser.help_mode()) {
+        vector<int> relative_times = opts.get_list<int>("relative_times");
+        if (!relative_times.empty() &&
+            relative_times.size() != opts.get_list<ParseTree>("engine_configs").size()) {
+            parser.error("need one relative time per component");
+        }
+        for (int relative_time : relative_times) {
+            if (relative_time <= 0) {
+                parser.error("relative times must be positive");
+            }
+        }
+    }
+
+    if (parser.help_mode()) {
+        return nullptr;
+    } else if (parser.dry_run()) {
+        //check if the supplied search engines can be parsed
+        for (const ParseTree &config : opts.get_list<ParseTree>("engine_configs")) {
+            OptionParser test_parser(config, parser.get_registry(),
+                                     parser.get_predefinitions(), true);
+            test_parser.start_parsing<shared_ptr<SearchEngine>>();
+        }
+        return nullptr;
+    } else {
+        return make_shared<PortfolioSearch>(opts, parser.get_registry(),
+                                            parser.get_predefinitions());
+    }
+}
+
+static Plugin<SearchEngine> _plugin("portfolio", _parse);
+}
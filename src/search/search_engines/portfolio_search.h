@@ -0,0 +1,49 @@
+#ifndef SEARCH_ENGINES_PORTFOLIO_SEARCH_H
+#define SEARCH_ENGINES_PORTFOLIO_SEARCH_H
+
+#include "search_engine_factory.h"
+
+#include "../option_parser_util.h"
+#include "../search_engine.h"
+
+#include <memory>
+
+namespace options {
+class Options;
+}
+
+namespace utils {
+class CountdownTimer;
+}
+
+namespace portfolio_search {
+class PortfolioSearch : public SearchEngine {
+    const std::vector<options::ParseTree> engine_configs;
+    std::vector<int> relative_times;
+    search_engine_factory::SearchEngineFactory engine_factory;
+    bool optimal;
+
+    std::unique_ptr<utils::CountdownTimer> portfolio_timer;
+    // Components of the current round and of the next round.
+    std::vector<int> current_round;
+    std::vector<int> next_round;
+    int round_position;
+    int best_bound;
+
+    std::shared_ptr<SearchEngine> create_component(int component);
+    double compute_time_slice() const;
+
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    PortfolioSearch(const options::Options &opts, options::Registry &registry,
+                    const options::Predefinitions &predefinitions);
+    virtual ~PortfolioSearch() override;
+
+    virtual void save_plan_if_necessary() override;
+    virtual void print_statistics() const override;
+};
+}
+
+#endif
@@ -0,0 +1,82 @@
+#include "search_engine_factory.h"
+
+#include "../evaluator.h"
+#include "../option_parser.h"
+#include "../search_engine.h"
+#include "../state_registry.h"
+
+#include <sstream>
+
+using namespace std;
+
+namespace search_engine_factory {
+/*
+  Name of the predefinition of the shared state registry. Predefinitions
+  from the command line cannot have this name.
+*/
+static const string SHARED_STATE_REGISTRY = "<shared state registry>";
+
+SearchEngineFactory::SearchEngineFactory(
+    const options::Registry &registry,
+    const options::Predefinitions &predefinitions,
+    const TaskProxy &task_proxy, bool share_components)
+    : registry(registry),
+      predefinitions(predefinitions) {
+    if (share_components) {
+        shared_state_registry = make_shared<StateRegistry>(task_proxy);
+        this->predefinitions.predefine(
+            SHARED_STATE_REGISTRY, shared_state_registry);
+    }
+}
+
+static bool is_evaluator_plugin(
+    const options::Registry &registry, const string &name) {
+    try {
+        registry.get_factory<shared_ptr<Evaluator>>(name);
+        return true;
+    } catch (const out_of_range &) {
+        return false;
+    }
+}
+
+/*
+  Replace each evaluator in the given configuration by a predefinition
+  named after the configuration of the evaluator. Inner evaluators are
+  replaced first, so that e.g. the "ff()" in "sum([g(), ff()])" and in
+  "ff()" refer to the same object.
+*/
+void SearchEngineFactory::share_evaluators(
+    options::ParseTree &config, options::ParseTree::sibling_iterator node) {
+    for (auto child = config.begin(node); child != config.end(node); ++child) {
+        share_evaluators(config, child);
+    }
+    if (!is_evaluator_plugin(registry, node->value)) {
+        return;
+    }
+    options::ParseTree evaluator_config = subtree(config, node);
+    evaluator_config.begin()->key.clear();
+    ostringstream stream;
+    kptree::print_tree_bracketed(evaluator_config, stream);
+    string name = stream.str();
+    if (!predefinitions.contains(name)) {
+        OptionParser parser(evaluator_config, registry, predefinitions, false);
+        predefinitions.predefine(
+            name, parser.start_parsing<shared_ptr<Evaluator>>());
+    }
+    config.erase_children(node);
+    node->value = name;
+}
+
+shared_ptr<SearchEngine> SearchEngineFactory::create_search_engine(
+    const options::ParseTree &config) {
+    options::ParseTree engine_config = config;
+    if (shared_state_registry) {
+        share_evaluators(engine_config, engine_config.begin());
+        engine_config.append_child(
+            engine_config.begin(),
+            options::ParseNode(SHARED_STATE_REGISTRY, "state_registry"));
+    }
+    OptionParser parser(engine_config, registry, predefinitions, false);
+    return parser.start_parsing<shared_ptr<SearchEngine>>();
+}
+}
@@ -0,0 +1,46 @@
+#ifndef SEARCH_ENGINES_SEARCH_ENGINE_FACTORY_H
+#define SEARCH_ENGINES_SEARCH_ENGINE_FACTORY_H
+
+#include "../options/parse_tree.h"
+#include "../options/predefinitions.h"
+#include "../options/registries.h"
+
+#include <memory>
+
+class SearchEngine;
+class StateRegistry;
+class TaskProxy;
+
+namespace search_engine_factory {
+/*
+  Create the search engines that iterated and portfolio search run one
+  after the other.
+
+  If share_components is set, all created engines register their states
+  in the same StateRegistry and evaluators with identical configurations
+  are only created once. Evaluators that cache their values per state then
+  reuse the values of all states that earlier engines evaluated.
+*/
+class SearchEngineFactory {
+    /*
+      We need to copy the registry and predefinitions here since they live
+      longer than the objects referenced in the constructor.
+    */
+    options::Registry registry;
+    options::Predefinitions predefinitions;
+    std::shared_ptr<StateRegistry> shared_state_registry;
+
+    void share_evaluators(
+        options::ParseTree &config, options::ParseTree::sibling_iterator node);
+public:
+    SearchEngineFactory(
+        const options::Registry &registry,
+        const options::Predefinitions &predefinitions,
+        const TaskProxy &task_proxy, bool share_components);
+
+    std::shared_ptr<SearchEngine> create_search_engine(
+        const options::ParseTree &config);
+};
+}
+
+#endif
@@ -42,6 +42,10 @@ public:
       state.
     */
     bool check_progress(const EvaluationContext &eval_context);
+
+    const std::unordered_map<const Evaluator *, int> &get_min_values() const {
+        return min_values;
+    }
 };
 
 #endif
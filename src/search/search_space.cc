@@ -118,7 +118,8 @@ void SearchNode::dump(const TaskProxy &task_proxy, utils::LogProxy &log) const {
 }
 
 SearchSpace::SearchSpace(StateRegistry &state_registry, utils::LogProxy &log)
-    : state_registry(state_registry), log(log) {
+    : search_node_infos(SearchNodeInfo(), "search_nodes"),
+      state_registry(state_registry), log(log) {
 }
 
 SearchNode SearchSpace::get_node(const State &state) {
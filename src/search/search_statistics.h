@@ -54,6 +54,8 @@ public:
     int get_generated() const {return generated_states;}
     int get_reopened() const {return reopened_states;}
     int get_generated_ops() const {return generated_ops;}
+    // Return the highest f value reported so far or -1 if there is none.
+    int get_lastjump_f_value() const {return lastjump_f_value;}
 
     /*
       Call the following method with the f value of every expanded
@@ -0,0 +1,106 @@
+#include "search_telemetry.h"
+
+#include "evaluator.h"
+#include "search_progress.h"
+#include "search_statistics.h"
+#include "state_registry.h"
+
+#include "utils/strings.h"
+#include "utils/system.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+SearchTelemetry::SearchTelemetry(
+    const string &filename, double interval,
+    const SearchStatistics &statistics,
+    const SearchProgress &search_progress,
+    const StateRegistry &state_registry)
+    : stream(filename, ios::app),
+      interval(interval),
+      statistics(statistics),
+      search_progress(search_progress),
+      state_registry(state_registry),
+      next_record_time(interval),
+      last_record_time(0),
+      last_expanded(0),
+      last_evaluations(0) {
+    if (stream.rdstate() & ofstream::failbit) {
+        cerr << "Failed to open telemetry file: " << filename << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+void SearchTelemetry::write_record(double search_time, int open_list_size) {
+    int expanded = statistics.get_expanded();
+    int evaluations = statistics.get_evaluations();
+    double elapsed = search_time - last_record_time;
+    double expansions_per_second = 0;
+    double evaluations_per_second = 0;
+    if (elapsed > 0) {
+        expansions_per_second = (expanded - last_expanded) / elapsed;
+        evaluations_per_second = (evaluations - last_evaluations) / elapsed;
+    }
+
+    // Sort the evaluators by description to obtain a deterministic order.
+    vector<pair<string, int>> min_values;
+    for (const auto &entry : search_progress.get_min_values()) {
+        min_values.emplace_back(entry.first->get_description(), entry.second);
+    }
+    sort(min_values.begin(), min_values.end());
+
+    /* Compose the record before writing it, so that readers of a pipe
+       receive complete lines. */
+    ostringstream record;
+    record << "{\"search_time\": " << search_time
+           << ", \"expanded\": " << expanded
+           << ", \"evaluated\": " << statistics.get_evaluated_states()
+           << ", \"evaluations\": " << evaluations
+           << ", \"generated\": " << statistics.get_generated()
+           << ", \"expansions_per_second\": " << expansions_per_second
+           << ", \"evaluations_per_second\": " << evaluations_per_second;
+    int f = statistics.get_lastjump_f_value();
+    if (f >= 0) {
+        record << ", \"f\": " << f;
+    }
+    record << ", \"h\": {";
+    for (size_t i = 0; i < min_values.size(); ++i) {
+        if (i > 0) {
+            record << ", ";
+        }
+        record << utils::to_json_string(min_values[i].first) << ": "
+               << min_values[i].second;
+    }
+    record << "}";
+    if (open_list_size >= 0) {
+        record << ", \"open_list_size\": " << open_list_size;
+    }
+    record << ", \"registered_states\": " << state_registry.size()
+           << ", \"state_registry_bytes\": "
+           << state_registry.estimate_memory_in_bytes()
+           << ", \"per_state_information_bytes\": [";
+    vector<pair<string, size_t>> subscriber_memory =
+        state_registry.estimate_subscriber_memory_in_bytes();
+    for (size_t i = 0; i < subscriber_memory.size(); ++i) {
+        if (i > 0) {
+            record << ", ";
+        }
+        record << "{\"name\": " << utils::to_json_string(subscriber_memory[i].first)
+               << ", \"bytes\": " << subscriber_memory[i].second << "}";
+    }
+    record << "], \"resident_memory_kb\": " << utils::get_resident_memory_in_kb()
+           << ", \"peak_memory_kb\": " << utils::get_peak_memory_in_kb()
+           << "}\n";
+    stream << record.str() << flush;
+
+    last_record_time = search_time;
+    last_expanded = expanded;
+    last_evaluations = evaluations;
+    next_record_time = search_time + interval;
+}
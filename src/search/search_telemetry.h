@@ -0,0 +1,60 @@
+#ifndef SEARCH_TELEMETRY_H
+#define SEARCH_TELEMETRY_H
+
+#include <fstream>
+#include <string>
+
+class SearchProgress;
+class SearchStatistics;
+class StateRegistry;
+
+/*
+  This class periodically writes the progress and memory usage of a search
+  to a file, so that external processes can monitor long-running searches.
+
+  Each record is a JSON object on a line of its own. It contains the
+  search statistics, the expansion and evaluation rates since the previous
+  record, the current f layer (for searches that report f values), the
+  best values of the evaluators that report minima, the open list size,
+  the memory used by the state registry and by each PerStateInformation
+  (or PerStateArray) of the registry together with its name, and the
+  resident and peak memory of the process.
+
+  Records are appended to the file, so that the phases of iterated and
+  portfolio searches can write to the same file.
+
+  The file can be a named pipe. Since opening a pipe for writing blocks
+  until a reader opens it, the search only starts once a reader is
+  connected.
+*/
+class SearchTelemetry {
+    std::ofstream stream;
+    const double interval;
+    const SearchStatistics &statistics;
+    const SearchProgress &search_progress;
+    const StateRegistry &state_registry;
+
+    double next_record_time;
+    double last_record_time;
+    int last_expanded;
+    int last_evaluations;
+
+public:
+    SearchTelemetry(
+        const std::string &filename, double interval,
+        const SearchStatistics &statistics,
+        const SearchProgress &search_progress,
+        const StateRegistry &state_registry);
+
+    bool is_record_due(double search_time) const {
+        return search_time >= next_record_time;
+    }
+
+    /*
+      Write a record for the given search time. Pass -1 as open list size
+      if the search has no open list.
+    */
+    void write_record(double search_time, int open_list_size);
+};
+
+#endif
@@ -5,6 +5,7 @@
 
 #include "task_utils/task_properties.h"
 #include "utils/logging.h"
+#include "utils/profiling.h"
 
 using namespace std;
 
@@ -63,6 +64,7 @@ const State &StateRegistry::get_initial_state() {
 //     out of the StateRegistry. This could for example be done by global functions
 //     operating on state buffers (PackedStateBin *).
 State StateRegistry::get_successor_state(const State &predecessor, const OperatorProxy &op) {
+    PROFILE_SCOPE("state registration");
     assert(!op.is_axiom());
     state_data_pool.push_back(predecessor.get_buffer());
     PackedStateBin *buffer = state_data_pool[state_data_pool.size() - 1];
@@ -103,6 +105,11 @@ int StateRegistry::get_state_size_in_bytes() const {
     return get_bins_per_state() * sizeof(PackedStateBin);
 }
 
+size_t StateRegistry::estimate_memory_in_bytes() const {
+    return state_data_pool.estimate_memory_in_bytes() +
+           registered_states.estimate_memory_in_bytes();
+}
+
 void StateRegistry::print_statistics(utils::LogProxy &log) const {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
@@ -212,6 +212,9 @@ public:
 
     int get_state_size_in_bytes() const;
 
+    // Estimate the memory for the state data and the hash set of states.
+    size_t estimate_memory_in_bytes() const;
+
     void print_statistics(utils::LogProxy &log) const;
 
     class const_iterator : public std::iterator<
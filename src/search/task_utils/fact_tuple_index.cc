@@ -0,0 +1,101 @@
+#include "fact_tuple_index.h"
+
+#include "../task_proxy.h"
+
+#include "../utils/system.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+
+using namespace std;
+
+namespace fact_tuple_index {
+FactTupleIndex::FactTupleIndex(const VariablesProxy &variables, int max_size)
+    : max_size(max_size),
+      num_facts(0) {
+    assert(max_size >= 1);
+    for (VariableProxy var : variables) {
+        fact_offsets.push_back(num_facts);
+        int domain_size = var.get_domain_size();
+        fact_to_var.insert(fact_to_var.end(), domain_size, var.get_id());
+        num_facts += domain_size;
+    }
+
+    const int64_t max_rank = numeric_limits<int>::max();
+    binomials.resize(max_size + 1);
+    rank_offsets.push_back(0);
+    /* C(n, k) = C(n - 1, k - 1) + C(n - 1, k). We compute these values
+       in 64 bits and abort if the number of ranks does not fit into an int. */
+    vector<int64_t> previous_row(num_facts + 1, 1);
+    for (int k = 1; k <= max_size; ++k) {
+        vector<int64_t> row(num_facts + 1, 0);
+        for (int n = 1; n <= num_facts; ++n) {
+            row[n] = min(previous_row[n - 1] + row[n - 1], max_rank + 1);
+        }
+        int64_t num_ranks = rank_offsets.back() + row[num_facts];
+        if (num_ranks > max_rank) {
+            cerr << "Too many fact sets of size at most " << max_size
+                 << " for " << num_facts << " facts." << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+        binomials[k].assign(row.begin(), row.begin() + num_facts);
+        rank_offsets.push_back(num_ranks);
+        previous_row.swap(row);
+    }
+}
+
+int FactTupleIndex::get_fact_id(const FactPair &fact) const {
+    return get_fact_id(fact.var, fact.value);
+}
+
+FactPair FactTupleIndex::get_fact(int fact_id) const {
+    int var = fact_to_var[fact_id];
+    return FactPair(var, fact_id - fact_offsets[var]);
+}
+
+int FactTupleIndex::get_rank(const vector<FactPair> &facts) const {
+    int size = facts.size();
+    assert(size >= 1 && size <= max_size);
+    int rank = get_rank_offset(size);
+    for (int i = 0; i < size; ++i) {
+        assert(i == 0 || facts[i - 1].var < facts[i].var);
+        rank += get_rank_summand(get_fact_id(facts[i]), i + 1);
+    }
+    return rank;
+}
+
+int FactTupleIndex::get_rank(const vector<int> &fact_ids) const {
+    int size = fact_ids.size();
+    assert(size >= 1 && size <= max_size);
+    int rank = get_rank_offset(size);
+    for (int i = 0; i < size; ++i) {
+        assert(i == 0 || fact_ids[i - 1] < fact_ids[i]);
+        rank += get_rank_summand(fact_ids[i], i + 1);
+    }
+    return rank;
+}
+
+int FactTupleIndex::get_size(int rank) const {
+    assert(rank >= 0 && rank < get_num_ranks());
+    int size = upper_bound(rank_offsets.begin(), rank_offsets.end(), rank) -
+        rank_offsets.begin();
+    assert(size >= 1 && size <= max_size);
+    return size;
+}
+
+void FactTupleIndex::get_fact_ids(int rank, vector<int> &fact_ids) const {
+    int size = get_size(rank);
+    int remainder = rank - get_rank_offset(size);
+    fact_ids.resize(size);
+    for (int position = size; position >= 1; --position) {
+        const vector<int> &column = binomials[position];
+        int fact_id = upper_bound(column.begin(), column.end(), remainder) -
+            column.begin() - 1;
+        fact_ids[position - 1] = fact_id;
+        remainder -= column[fact_id];
+    }
+    assert(remainder == 0);
+}
+}
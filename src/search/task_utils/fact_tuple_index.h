@@ -0,0 +1,111 @@
+#ifndef TASK_UTILS_FACT_TUPLE_INDEX_H
+#define TASK_UTILS_FACT_TUPLE_INDEX_H
+
+#include <cassert>
+#include <vector>
+
+class FactPair;
+class VariablesProxy;
+
+namespace fact_tuple_index {
+/*
+  Assign a dense index (rank) to each set of at most max_size facts.
+
+  Facts are numbered consecutively by variable and value, so sorting a set
+  of facts by ID also sorts it by variable. A set {f_1 < ... < f_k} has the
+  rank rank_offset(k) + C(f_1, 1) + ... + C(f_k, k) in the combinatorial
+  number system, which means the ranks of all sets of size k form the
+  contiguous block [rank_offset(k), rank_offset(k + 1)). Callers usually
+  only use sets with pairwise distinct variables. The ranks of all other
+  sets stay unused, so arrays indexed by rank contain some gaps.
+*/
+class FactTupleIndex {
+    int max_size;
+    int num_facts;
+    std::vector<int> fact_offsets;
+    std::vector<int> fact_to_var;
+    // binomials[k][n] = C(n, k) for 1 <= k <= max_size and 0 <= n < num_facts.
+    std::vector<std::vector<int>> binomials;
+    // rank_offsets[k - 1] is the first rank of the sets of size k.
+    std::vector<int> rank_offsets;
+
+    template<typename Callback>
+    void for_each_subset_rank_rec(
+        const std::vector<int> &fact_ids, int start, int size,
+        int partial_rank, int last_var, const Callback &callback) const {
+        int num_ids = fact_ids.size();
+        for (int i = start; i < num_ids; ++i) {
+            int fact_id = fact_ids[i];
+            int var = fact_to_var[fact_id];
+            if (var == last_var)
+                continue;
+            int rank = partial_rank + get_rank_summand(fact_id, size + 1);
+            callback(get_rank_offset(size + 1) + rank);
+            if (size + 1 < max_size) {
+                for_each_subset_rank_rec(
+                    fact_ids, i + 1, size + 1, rank, var, callback);
+            }
+        }
+    }
+
+public:
+    FactTupleIndex(const VariablesProxy &variables, int max_size);
+
+    int get_max_size() const {
+        return max_size;
+    }
+
+    int get_num_facts() const {
+        return num_facts;
+    }
+
+    int get_num_ranks() const {
+        return rank_offsets.back();
+    }
+
+    int get_fact_id(int var, int value) const {
+        return fact_offsets[var] + value;
+    }
+
+    int get_fact_id(const FactPair &fact) const;
+    FactPair get_fact(int fact_id) const;
+
+    int get_variable(int fact_id) const {
+        return fact_to_var[fact_id];
+    }
+
+    // Number of facts in the set with the given rank.
+    int get_size(int rank) const;
+
+    int get_rank_offset(int size) const {
+        assert(size >= 1 && size <= max_size);
+        return rank_offsets[size - 1];
+    }
+
+    /* Contribution of the fact at the given (1-based) position of a sorted
+       set to the rank of that set. */
+    int get_rank_summand(int fact_id, int position) const {
+        assert(position >= 1 && position <= max_size);
+        return binomials[position][fact_id];
+    }
+
+    // The facts must be sorted by variable.
+    int get_rank(const std::vector<FactPair> &facts) const;
+    // The fact IDs must be sorted.
+    int get_rank(const std::vector<int> &fact_ids) const;
+    // Inverse of get_rank: store the sorted fact IDs of the set in fact_ids.
+    void get_fact_ids(int rank, std::vector<int> &fact_ids) const;
+
+    /*
+      Call callback(rank) for each nonempty subset of at most max_size of the
+      given sorted fact IDs whose facts have pairwise distinct variables.
+    */
+    template<typename Callback>
+    void for_each_subset_rank(
+        const std::vector<int> &fact_ids, const Callback &callback) const {
+        for_each_subset_rank_rec(fact_ids, 0, 0, 0, -1, callback);
+    }
+};
+}
+
+#endif
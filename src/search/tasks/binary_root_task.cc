@@ -0,0 +1,545 @@
+#include "binary_root_task.h"
+
+#include "../abstract_task.h"
+#include "../axioms.h"
+#include "../task_proxy.h"
+
+#include "../utils/mapped_file.h"
+#include "../utils/memory.h"
+#include "../utils/system.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+using utils::ExitCode;
+
+/*
+  Layout of a binary task. The file starts with the 8 bytes of
+  BINARY_TASK_MAGIC, followed by 32-bit integers in native byte order:
+
+  header: byte order mark, version, use_metric, number of variables,
+      facts, mutex entries, goals and strings, size of the string data
+  variables: (name string, axiom layer, domain size, first fact name string)
+  initial state: one value per variable
+  mutex offsets: for each fact (numbered consecutively by variable and
+      value) the index of its first mutex entry, plus a sentinel
+  mutex entries: (var, value) pairs, sorted for each fact
+  goals: (var, value) pairs
+  operators and then axioms, each given as
+      number of actions, preconditions, effects and effect conditions
+      actions: (first precondition, first effect, cost, name string),
+          plus a sentinel entry
+      preconditions: (var, value) pairs
+      effects: (var, value, first effect condition), plus a sentinel entry
+      effect conditions: (var, value) pairs
+  string offsets: start of each string in the string data, plus a sentinel
+  string data: characters of all strings without terminators
+
+  Preprocess-h2 writes this layout in helper_functions.cc. The two
+  implementations have to be kept in sync.
+*/
+namespace tasks {
+static const char BINARY_TASK_MAGIC[8] = {'\x7f', 'F', 'D', 'T', 'A', 'S', 'K', '\n'};
+static const int32_t BYTE_ORDER_MARK = 0x01020304;
+static const int32_t BINARY_TASK_VERSION = 1;
+
+static const int VARIABLE_ENTRY_SIZE = 4;
+static const int ACTION_ENTRY_SIZE = 4;
+static const int EFFECT_ENTRY_SIZE = 3;
+
+NO_RETURN static void exit_with_input_error(const string &message) {
+    cerr << "Invalid binary task: " << message << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+class BinaryReader {
+    const char *pos;
+    const char *end;
+
+public:
+    BinaryReader(const char *begin, const char *end)
+        : pos(begin), end(end) {
+    }
+
+    const char *read_chars(int64_t count) {
+        if (count < 0 || count > end - pos) {
+            exit_with_input_error("unexpected end of file");
+        }
+        const char *chars = pos;
+        pos += count;
+        return chars;
+    }
+
+    const int32_t *read_ints(int64_t count) {
+        if (count < 0) {
+            exit_with_input_error("negative size");
+        }
+        return reinterpret_cast<const int32_t *>(
+            read_chars(count * sizeof(int32_t)));
+    }
+
+    int read_int() {
+        return *read_ints(1);
+    }
+
+    int read_count() {
+        int count = read_int();
+        if (count < 0) {
+            exit_with_input_error("negative size");
+        }
+        return count;
+    }
+
+    bool at_end() const {
+        return pos == end;
+    }
+};
+
+struct BinaryActions {
+    int num_actions;
+    const int32_t *actions;
+    const int32_t *preconditions;
+    const int32_t *effects;
+    const int32_t *conditions;
+
+    int get_first_precondition(int action) const {
+        return actions[action * ACTION_ENTRY_SIZE];
+    }
+
+    int get_first_effect(int action) const {
+        return actions[action * ACTION_ENTRY_SIZE + 1];
+    }
+
+    int get_cost(int action) const {
+        return actions[action * ACTION_ENTRY_SIZE + 2];
+    }
+
+    int get_name(int action) const {
+        return actions[action * ACTION_ENTRY_SIZE + 3];
+    }
+
+    int get_first_condition(int effect) const {
+        return effects[effect * EFFECT_ENTRY_SIZE + 2];
+    }
+
+    FactPair get_effect(int effect) const {
+        return FactPair(effects[effect * EFFECT_ENTRY_SIZE],
+                        effects[effect * EFFECT_ENTRY_SIZE + 1]);
+    }
+};
+
+static FactPair get_fact(const int32_t *facts, int index) {
+    return FactPair(facts[2 * index], facts[2 * index + 1]);
+}
+
+static void check_offsets(
+    const int32_t *entries, int num_entries, int entry_size, int offset,
+    int num_targets, const string &name) {
+    int previous = 0;
+    for (int i = 0; i <= num_entries; ++i) {
+        int target = entries[i * entry_size + offset];
+        if (target < previous || target > num_targets) {
+            exit_with_input_error("invalid " + name + " offsets");
+        }
+        previous = target;
+    }
+    if (previous != num_targets) {
+        exit_with_input_error("invalid " + name + " offsets");
+    }
+}
+
+
+class BinaryRootTask : public AbstractTask {
+    unique_ptr<utils::MappedFile> file;
+
+    bool use_metric;
+    int num_variables;
+    const int32_t *variables;
+    const int32_t *initial_state;
+    // First fact ID of each variable.
+    vector<int> fact_offsets;
+    const int32_t *mutex_offsets;
+    const int32_t *mutex_facts;
+    int num_goals;
+    const int32_t *goals;
+    BinaryActions operators;
+    BinaryActions axioms;
+    int num_strings;
+    const int32_t *string_offsets;
+    const char *string_data;
+
+    vector<int> initial_state_values;
+
+    int get_variable_entry(int var, int field) const {
+        assert(var >= 0 && var < num_variables);
+        return variables[var * VARIABLE_ENTRY_SIZE + field];
+    }
+
+    const BinaryActions &get_actions(bool is_axiom) const {
+        return is_axiom ? axioms : operators;
+    }
+
+    string get_string(int index) const;
+
+    void check_fact(const FactPair &fact) const;
+    void check_facts(const int32_t *facts, int num_facts) const;
+    void check_string(int index) const;
+    BinaryActions read_actions(BinaryReader &reader, bool is_axiom) const;
+
+public:
+    explicit BinaryRootTask(istream &in);
+
+    virtual int get_num_variables() const override;
+    virtual string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual int get_variable_axiom_layer(int var) const override;
+    virtual int get_variable_default_axiom_value(int var) const override;
+    virtual string get_fact_name(const FactPair &fact) const override;
+    virtual bool are_facts_mutex(
+        const FactPair &fact1, const FactPair &fact2) const override;
+
+    virtual int get_operator_cost(int index, bool is_axiom) const override;
+    virtual string get_operator_name(
+        int index, bool is_axiom) const override;
+    virtual int get_num_operators() const override;
+    virtual int get_num_operator_preconditions(
+        int index, bool is_axiom) const override;
+    virtual FactPair get_operator_precondition(
+        int op_index, int fact_index, bool is_axiom) const override;
+    virtual int get_num_operator_effects(
+        int op_index, bool is_axiom) const override;
+    virtual int get_num_operator_effect_conditions(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect_condition(
+        int op_index, int eff_index, int cond_index, bool is_axiom) const override;
+    virtual FactPair get_operator_effect(
+        int op_index, int eff_index, bool is_axiom) const override;
+    virtual int convert_operator_index(
+        int index, const AbstractTask *ancestor_task) const override;
+
+    virtual int get_num_axioms() const override;
+
+    virtual int get_num_goals() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual vector<int> get_initial_state_values() const override;
+    virtual void convert_ancestor_state_values(
+        vector<int> &values,
+        const AbstractTask *ancestor_task) const override;
+    virtual bool does_convert_ancestor_state_values(
+        const AbstractTask *ancestor_task) const override;
+};
+
+
+BinaryRootTask::BinaryRootTask(istream &in)
+    : file(utils::make_unique_ptr<utils::MappedFile>(in)) {
+    BinaryReader reader(file->get_data(), file->get_data() + file->get_size());
+    const char *magic = reader.read_chars(sizeof(BINARY_TASK_MAGIC));
+    if (memcmp(magic, BINARY_TASK_MAGIC, sizeof(BINARY_TASK_MAGIC)) != 0) {
+        exit_with_input_error("wrong magic bytes");
+    }
+    if (reader.read_int() != BYTE_ORDER_MARK) {
+        exit_with_input_error("file was written with a different byte order");
+    }
+    int version = reader.read_int();
+    if (version != BINARY_TASK_VERSION) {
+        cerr << "Expected binary task version " << BINARY_TASK_VERSION
+             << ", got " << version << "." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    use_metric = reader.read_int();
+    num_variables = reader.read_count();
+    int num_facts = reader.read_count();
+    int num_mutex_facts = reader.read_count();
+    num_goals = reader.read_count();
+    num_strings = reader.read_count();
+    int num_string_chars = reader.read_count();
+
+    variables = reader.read_ints(
+        static_cast<int64_t>(num_variables) * VARIABLE_ENTRY_SIZE);
+    fact_offsets.reserve(num_variables);
+    int64_t fact_id = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        fact_offsets.push_back(fact_id);
+        int domain_size = get_variable_domain_size(var);
+        if (domain_size < 1) {
+            exit_with_input_error("empty variable domain");
+        }
+        check_string(get_variable_entry(var, 0));
+        check_string(get_variable_entry(var, 3));
+        check_string(get_variable_entry(var, 3) + domain_size - 1);
+        fact_id += domain_size;
+    }
+    if (fact_id != num_facts) {
+        exit_with_input_error("wrong number of facts");
+    }
+
+    initial_state = reader.read_ints(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        check_fact(FactPair(var, initial_state[var]));
+    }
+
+    mutex_offsets = reader.read_ints(static_cast<int64_t>(num_facts) + 1);
+    check_offsets(mutex_offsets, num_facts, 1, 0, num_mutex_facts, "mutex");
+    mutex_facts = reader.read_ints(2 * static_cast<int64_t>(num_mutex_facts));
+    check_facts(mutex_facts, num_mutex_facts);
+    for (int fact = 0; fact < num_facts; ++fact) {
+        for (int i = mutex_offsets[fact] + 1; i < mutex_offsets[fact + 1]; ++i) {
+            if (!(get_fact(mutex_facts, i - 1) < get_fact(mutex_facts, i))) {
+                exit_with_input_error("mutexes are not sorted");
+            }
+        }
+    }
+
+    goals = reader.read_ints(2 * static_cast<int64_t>(num_goals));
+    if (num_goals == 0) {
+        cerr << "Task has no goal condition!" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    check_facts(goals, num_goals);
+
+    operators = read_actions(reader, false);
+    axioms = read_actions(reader, true);
+
+    string_offsets = reader.read_ints(static_cast<int64_t>(num_strings) + 1);
+    check_offsets(string_offsets, num_strings, 1, 0, num_string_chars, "string");
+    string_data = reader.read_chars(num_string_chars);
+    if (!reader.at_end()) {
+        exit_with_input_error("unexpected data at end of file");
+    }
+
+    initial_state_values.assign(initial_state, initial_state + num_variables);
+    /*
+      HACK: We use a TaskProxy to access g_axiom_evaluators here which assumes
+      that this task is completely constructed.
+    */
+    AxiomEvaluator &axiom_evaluator = g_axiom_evaluators[TaskProxy(*this)];
+    axiom_evaluator.evaluate(initial_state_values);
+}
+
+BinaryActions BinaryRootTask::read_actions(
+    BinaryReader &reader, bool is_axiom) const {
+    BinaryActions result;
+    result.num_actions = reader.read_count();
+    int num_preconditions = reader.read_count();
+    int num_effects = reader.read_count();
+    int num_conditions = reader.read_count();
+    int64_t num_actions = result.num_actions;
+    result.actions = reader.read_ints((num_actions + 1) * ACTION_ENTRY_SIZE);
+    result.preconditions = reader.read_ints(2 * static_cast<int64_t>(num_preconditions));
+    result.effects = reader.read_ints(
+        (static_cast<int64_t>(num_effects) + 1) * EFFECT_ENTRY_SIZE);
+    result.conditions = reader.read_ints(2 * static_cast<int64_t>(num_conditions));
+
+    string kind = is_axiom ? "axiom" : "operator";
+    check_offsets(result.actions, result.num_actions, ACTION_ENTRY_SIZE, 0,
+                  num_preconditions, kind + " precondition");
+    check_offsets(result.actions, result.num_actions, ACTION_ENTRY_SIZE, 1,
+                  num_effects, kind + " effect");
+    check_offsets(result.effects, num_effects, EFFECT_ENTRY_SIZE, 2,
+                  num_conditions, kind + " effect condition");
+    for (int action = 0; action < result.num_actions; ++action) {
+        if (result.get_cost(action) < 0) {
+            exit_with_input_error("negative " + kind + " cost");
+        }
+        if (!is_axiom) {
+            check_string(result.get_name(action));
+        }
+    }
+    check_facts(result.preconditions, num_preconditions);
+    for (int effect = 0; effect < num_effects; ++effect) {
+        check_fact(result.get_effect(effect));
+    }
+    check_facts(result.conditions, num_conditions);
+    return result;
+}
+
+void BinaryRootTask::check_fact(const FactPair &fact) const {
+    if (fact.var < 0 || fact.var >= num_variables) {
+        cerr << "Invalid variable id: " << fact.var << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    if (fact.value < 0 || fact.value >= get_variable_domain_size(fact.var)) {
+        cerr << "Invalid value for variable " << fact.var << ": " << fact.value << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+}
+
+void BinaryRootTask::check_facts(const int32_t *facts, int num_facts) const {
+    for (int i = 0; i < num_facts; ++i) {
+        check_fact(get_fact(facts, i));
+    }
+}
+
+void BinaryRootTask::check_string(int index) const {
+    if (index < 0 || index >= num_strings) {
+        exit_with_input_error("invalid string index");
+    }
+}
+
+string BinaryRootTask::get_string(int index) const {
+    assert(index >= 0 && index < num_strings);
+    int start = string_offsets[index];
+    return string(string_data + start, string_offsets[index + 1] - start);
+}
+
+int BinaryRootTask::get_num_variables() const {
+    return num_variables;
+}
+
+string BinaryRootTask::get_variable_name(int var) const {
+    return get_string(get_variable_entry(var, 0));
+}
+
+int BinaryRootTask::get_variable_domain_size(int var) const {
+    return get_variable_entry(var, 2);
+}
+
+int BinaryRootTask::get_variable_axiom_layer(int var) const {
+    return get_variable_entry(var, 1);
+}
+
+int BinaryRootTask::get_variable_default_axiom_value(int var) const {
+    assert(var >= 0 && var < num_variables);
+    return initial_state[var];
+}
+
+string BinaryRootTask::get_fact_name(const FactPair &fact) const {
+    assert(fact.value >= 0 && fact.value < get_variable_domain_size(fact.var));
+    return get_string(get_variable_entry(fact.var, 3) + fact.value);
+}
+
+bool BinaryRootTask::are_facts_mutex(
+    const FactPair &fact1, const FactPair &fact2) const {
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    int fact_id = fact_offsets[fact1.var] + fact1.value;
+    int begin = mutex_offsets[fact_id];
+    int end = mutex_offsets[fact_id + 1];
+    while (begin < end) {
+        int middle = begin + (end - begin) / 2;
+        if (get_fact(mutex_facts, middle) < fact2) {
+            begin = middle + 1;
+        } else {
+            end = middle;
+        }
+    }
+    return begin < mutex_offsets[fact_id + 1] &&
+           get_fact(mutex_facts, begin) == fact2;
+}
+
+int BinaryRootTask::get_operator_cost(int index, bool is_axiom) const {
+    if (is_axiom) {
+        return 0;
+    }
+    return use_metric ? operators.get_cost(index) : 1;
+}
+
+string BinaryRootTask::get_operator_name(int index, bool is_axiom) const {
+    if (is_axiom) {
+        return "<axiom>";
+    }
+    return get_string(operators.get_name(index));
+}
+
+int BinaryRootTask::get_num_operators() const {
+    return operators.num_actions;
+}
+
+int BinaryRootTask::get_num_operator_preconditions(
+    int index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    return actions.get_first_precondition(index + 1) -
+           actions.get_first_precondition(index);
+}
+
+FactPair BinaryRootTask::get_operator_precondition(
+    int op_index, int fact_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    return get_fact(actions.preconditions,
+                    actions.get_first_precondition(op_index) + fact_index);
+}
+
+int BinaryRootTask::get_num_operator_effects(
+    int op_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    return actions.get_first_effect(op_index + 1) -
+           actions.get_first_effect(op_index);
+}
+
+int BinaryRootTask::get_num_operator_effect_conditions(
+    int op_index, int eff_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    int effect = actions.get_first_effect(op_index) + eff_index;
+    return actions.get_first_condition(effect + 1) -
+           actions.get_first_condition(effect);
+}
+
+FactPair BinaryRootTask::get_operator_effect_condition(
+    int op_index, int eff_index, int cond_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    int effect = actions.get_first_effect(op_index) + eff_index;
+    return get_fact(actions.conditions,
+                    actions.get_first_condition(effect) + cond_index);
+}
+
+FactPair BinaryRootTask::get_operator_effect(
+    int op_index, int eff_index, bool is_axiom) const {
+    const BinaryActions &actions = get_actions(is_axiom);
+    return actions.get_effect(actions.get_first_effect(op_index) + eff_index);
+}
+
+int BinaryRootTask::convert_operator_index(
+    int index, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid operator ID conversion");
+    }
+    return index;
+}
+
+int BinaryRootTask::get_num_axioms() const {
+    return axioms.num_actions;
+}
+
+int BinaryRootTask::get_num_goals() const {
+    return num_goals;
+}
+
+FactPair BinaryRootTask::get_goal_fact(int index) const {
+    assert(index >= 0 && index < num_goals);
+    return get_fact(goals, index);
+}
+
+vector<int> BinaryRootTask::get_initial_state_values() const {
+    return initial_state_values;
+}
+
+void BinaryRootTask::convert_ancestor_state_values(
+    vector<int> &, const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion");
+    }
+}
+
+bool BinaryRootTask::does_convert_ancestor_state_values(
+    const AbstractTask *ancestor_task) const {
+    if (this != ancestor_task) {
+        ABORT("Invalid state conversion query");
+    }
+    return false;
+}
+
+bool is_binary_task(istream &in) {
+    return in.peek() == BINARY_TASK_MAGIC[0];
+}
+
+shared_ptr<AbstractTask> read_binary_root_task(istream &in) {
+    return make_shared<BinaryRootTask>(in);
+}
+}
@@ -0,0 +1,20 @@
+#ifndef TASKS_BINARY_ROOT_TASK_H
+#define TASKS_BINARY_ROOT_TASK_H
+
+#include <iostream>
+#include <memory>
+
+class AbstractTask;
+
+namespace tasks {
+/*
+  Tasks in the binary format written by "preprocess-h2 --binary_output"
+  contain the same information as the textual translator output, but store
+  it in flat arrays of 32-bit integers. The search uses these arrays
+  directly from the memory-mapped input file instead of parsing them.
+*/
+extern bool is_binary_task(std::istream &in);
+extern std::shared_ptr<AbstractTask> read_binary_root_task(std::istream &in);
+}
+
+#endif
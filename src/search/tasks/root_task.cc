@@ -1,5 +1,7 @@
 #include "root_task.h"
 
+#include "binary_root_task.h"
+
 #include "../option_parser.h"
 #include "../plugin.h"
 #include "../state_registry.h"
@@ -505,7 +507,10 @@ bool RootTask::does_convert_ancestor_state_values(
 
 void read_root_task(istream &in) {
     assert(!g_root_task);
-    g_root_task = make_shared<RootTask>(in);
+    if (is_binary_task(in))
+        g_root_task = read_binary_root_task(in);
+    else
+        g_root_task = make_shared<RootTask>(in);
 }
 
 static shared_ptr<AbstractTask> _parse(OptionParser &parser) {
@@ -0,0 +1,54 @@
+#include "mapped_file.h"
+
+#include "system.h"
+
+#include <iterator>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace utils {
+MappedFile::MappedFile(istream &in)
+    : data(nullptr),
+      size(0),
+      mapping(nullptr) {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    /*
+      We map the file from its start, so we may only do this if std::cin
+      has not consumed any input yet. We ask the stream for its position
+      instead of calling lseek(STDIN_FILENO, 0, SEEK_CUR), since peeking at
+      std::cin moves the file offset past all bytes buffered by stdio.
+      Otherwise, we read the remaining input into a buffer.
+    */
+    struct stat file_status;
+    if (&in == &cin && fstat(STDIN_FILENO, &file_status) == 0 &&
+        S_ISREG(file_status.st_mode) && file_status.st_size > 0 &&
+        in.tellg() == streampos(0)) {
+        void *address = mmap(nullptr, file_status.st_size, PROT_READ,
+                             MAP_PRIVATE, STDIN_FILENO, 0);
+        if (address != MAP_FAILED) {
+            mapping = address;
+            data = static_cast<const char *>(address);
+            size = file_status.st_size;
+            return;
+        }
+    }
+#endif
+    buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+}
+
+MappedFile::~MappedFile() {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    if (mapping) {
+        munmap(mapping, size);
+    }
+#endif
+}
+}
@@ -0,0 +1,45 @@
+#ifndef UTILS_MAPPED_FILE_H
+#define UTILS_MAPPED_FILE_H
+
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+namespace utils {
+/*
+  Read-only view of the complete contents of an input stream.
+
+  If the stream is std::cin, standard input is a regular file and nothing
+  has been read from it yet, the file is mapped into memory and its pages
+  are only loaded once they are accessed. Otherwise (pipes, partially read
+  input, Windows), the remaining input is read into a buffer.
+  In both cases the data is suitably aligned for reading integers.
+*/
+class MappedFile {
+    const char *data;
+    std::size_t size;
+    void *mapping;
+    std::vector<char> buffer;
+
+public:
+    explicit MappedFile(std::istream &in);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    const char *get_data() const {
+        return data;
+    }
+
+    std::size_t get_size() const {
+        return size;
+    }
+
+    bool is_memory_mapped() const {
+        return mapping != nullptr;
+    }
+};
+}
+
+#endif
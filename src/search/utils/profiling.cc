@@ -0,0 +1,80 @@
+#include "profiling.h"
+
+#include "memory.h"
+#include "strings.h"
+
+#include <memory>
+
+using namespace std;
+
+namespace utils {
+static vector<unique_ptr<ProfilingComponent>> &get_profiling_components() {
+    // Function-local static to avoid problems with static initialization order.
+    static vector<unique_ptr<ProfilingComponent>> components;
+    return components;
+}
+
+ProfilingComponent::ProfilingComponent(const string &name)
+    : name(name),
+      num_calls(0),
+      total_nanoseconds(0),
+      num_running_calls(0) {
+}
+
+void ProfilingComponent::add_call(int64_t nanoseconds) {
+    ++num_calls;
+    total_nanoseconds += nanoseconds;
+    size_t bucket = 0;
+    while (nanoseconds > 1) {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+    if (bucket >= latency_histogram.size()) {
+        latency_histogram.resize(bucket + 1, 0);
+    }
+    ++latency_histogram[bucket];
+}
+
+void ProfilingComponent::dump_json(ostream &os) const {
+    os << "{\"calls\": " << num_calls
+       << ", \"total_time\": " << total_nanoseconds / 1e9
+       << ", \"latency_histogram\": [";
+    for (size_t i = 0; i < latency_histogram.size(); ++i) {
+        if (i > 0) {
+            os << ", ";
+        }
+        os << latency_histogram[i];
+    }
+    os << "]}";
+}
+
+ProfilingComponent &get_profiling_component(const string &name) {
+    vector<unique_ptr<ProfilingComponent>> &components =
+        get_profiling_components();
+    for (const unique_ptr<ProfilingComponent> &component : components) {
+        if (component->get_name() == name) {
+            return *component;
+        }
+    }
+    components.push_back(make_unique_ptr<ProfilingComponent>(name));
+    return *components.back();
+}
+
+void dump_profile_json(ostream &os) {
+    os << "{";
+    bool first = true;
+    for (const unique_ptr<ProfilingComponent> &component :
+         get_profiling_components()) {
+        if (component->get_num_calls() == 0) {
+            continue;
+        }
+        if (!first) {
+            os << ", ";
+        }
+        first = false;
+        os << to_json_string(component->get_name()) << ": ";
+        component->dump_json(os);
+    }
+    os << "}";
+}
+}
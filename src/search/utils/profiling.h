@@ -0,0 +1,112 @@
+#ifndef UTILS_PROFILING_H
+#define UTILS_PROFILING_H
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace utils {
+/*
+  Low-overhead instrumentation of hot code paths such as evaluators,
+  successor generation, state registration and open-list operations.
+
+  Each profiling component counts the calls of the code it measures, sums
+  their durations and keeps a histogram of call latencies, where bucket i
+  counts the calls that took between 2^i and 2^(i+1) - 1 nanoseconds.
+  Calls nested in a running call of the same component (e.g., open lists
+  that delegate to their sublists) are counted as part of the outer call.
+
+  The timers are only compiled in if the planner is built with the CMake
+  option USE_PROFILING. Otherwise, the PROFILE_* macros below expand to
+  nothing and regular builds do not pay for the instrumentation.
+*/
+class ProfilingComponent {
+    std::string name;
+    int64_t num_calls;
+    int64_t total_nanoseconds;
+    std::vector<int64_t> latency_histogram;
+    int num_running_calls;
+
+    void add_call(int64_t nanoseconds);
+
+public:
+    explicit ProfilingComponent(const std::string &name);
+
+    void start_call() {
+        ++num_running_calls;
+    }
+
+    void stop_call(int64_t nanoseconds) {
+        if (--num_running_calls == 0) {
+            add_call(nanoseconds);
+        }
+    }
+
+    const std::string &get_name() const {
+        return name;
+    }
+
+    int64_t get_num_calls() const {
+        return num_calls;
+    }
+
+    void dump_json(std::ostream &os) const;
+};
+
+/*
+  Return the component with the given name, creating it on first use.
+  Components live until the end of the program, so callers may keep
+  references to them.
+*/
+extern ProfilingComponent &get_profiling_component(const std::string &name);
+
+// Write all components that have been called at least once as JSON object.
+extern void dump_profile_json(std::ostream &os);
+
+class ScopedProfilingTimer {
+    using Clock = std::chrono::steady_clock;
+
+    ProfilingComponent &component;
+    Clock::time_point start;
+
+public:
+    explicit ScopedProfilingTimer(ProfilingComponent &component)
+        : component(component),
+          start(Clock::now()) {
+        component.start_call();
+    }
+
+    ~ScopedProfilingTimer() {
+        component.stop_call(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Clock::now() - start).count());
+    }
+
+    ScopedProfilingTimer(const ScopedProfilingTimer &) = delete;
+    ScopedProfilingTimer &operator=(const ScopedProfilingTimer &) = delete;
+};
+}
+
+/*
+  PROFILE_SCOPE(name) measures the rest of the enclosing scope as part of
+  the component with the given (constant) name. The component is looked
+  up only once per call site.
+
+  PROFILE_COMPONENT_SCOPE(component) does the same for a component that
+  the caller looked up itself, e.g., the component of an evaluator.
+*/
+#ifdef USE_PROFILING
+#define PROFILE_SCOPE(name) \
+    static utils::ProfilingComponent &_profiling_component = \
+        utils::get_profiling_component(name); \
+    utils::ScopedProfilingTimer _profiling_timer(_profiling_component)
+#define PROFILE_COMPONENT_SCOPE(component) \
+    utils::ScopedProfilingTimer _profiling_timer(component)
+#else
+#define PROFILE_SCOPE(name)
+#define PROFILE_COMPONENT_SCOPE(component)
+#endif
+
+#endif
@@ -45,4 +45,20 @@ pair<string, string> split(const string &s, const string &separator) {
     string rhs = s.substr(split_pos + 1);
     return make_pair(lhs, rhs);
 }
+
+string to_json_string(const string &s) {
+    string result = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            result += ' ';
+        } else {
+            result += c;
+        }
+    }
+    result += '"';
+    return result;
+}
 }
@@ -28,6 +28,9 @@ extern std::pair<std::string, std::string> split(
 
 extern bool startswith(const std::string &s, const std::string &prefix);
 
+// Return s as quoted JSON string literal.
+extern std::string to_json_string(const std::string &s);
+
 template<typename Collection>
 std::string join(const Collection &collection, const std::string &delimiter) {
     std::ostringstream oss;
@@ -57,6 +57,8 @@ NO_RETURN extern void exit_with(ExitCode returncode);
 NO_RETURN extern void exit_after_receiving_signal(ExitCode returncode);
 
 int get_peak_memory_in_kb();
+// Return the current resident set size of the process.
+int get_resident_memory_in_kb();
 const char *get_exit_code_message_reentrant(ExitCode exitcode);
 bool is_exit_code_error_reentrant(ExitCode exitcode);
 void register_event_handlers();